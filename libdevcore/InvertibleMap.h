@@ -18,10 +18,17 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <set>
+#include <utility>
+#include <vector>
 
 /**
  * Data structure that keeps track of values and keys of a mapping.
+ *
+ * While a snapshot is open, all changes are journaled. This allows to
+ * determine the state at the time of the snapshot for all keys that have
+ * been changed since then, without copying the whole mapping.
  */
 template <class K, class V>
 struct InvertibleMap
@@ -32,6 +39,7 @@ struct InvertibleMap
 
 	void set(K _key, V _value)
 	{
+		journal(_key);
 		if (values.count(_key))
 			references[values[_key]].erase(_key);
 		values[_key] = _value;
@@ -41,7 +49,10 @@ struct InvertibleMap
 	void eraseKey(K _key)
 	{
 		if (values.count(_key))
+		{
+			journal(_key);
 			references[values[_key]].erase(_key);
+		}
 		values.erase(_key);
 	}
 
@@ -49,17 +60,65 @@ struct InvertibleMap
 	{
 		if (references.count(_value))
 		{
-			for (V v: references[_value])
-				values.erase(v);
+			for (K k: references[_value])
+			{
+				journal(k);
+				values.erase(k);
+			}
 			references.erase(_value);
 		}
 	}
 
 	void clear()
 	{
+		for (auto const& item: values)
+			journal(item.first);
 		values.clear();
 		references.clear();
 	}
+
+	/// Starts journaling changes. Snapshots have to be released
+	/// in the reverse order in which they were taken.
+	/// @returns an identifier of the snapshot.
+	size_t takeSnapshot()
+	{
+		++m_openSnapshots;
+		return m_journal.size();
+	}
+
+	/// Releases the most recently taken snapshot.
+	void releaseSnapshot()
+	{
+		if (--m_openSnapshots == 0)
+			m_journal.clear();
+	}
+
+	/// @returns the keys that have been changed since the snapshot was taken,
+	/// mapped to their values at the time of the snapshot (nullopt if they had no value).
+	std::map<K, std::optional<V>> changesSince(size_t _snapshot) const
+	{
+		std::map<K, std::optional<V>> changes;
+		for (size_t i = _snapshot; i < m_journal.size(); ++i)
+			changes.emplace(m_journal[i]);
+		return changes;
+	}
+
+private:
+	/// Records the current value of @a _key, if a snapshot is open.
+	void journal(K const& _key)
+	{
+		if (m_openSnapshots == 0)
+			return;
+		auto it = values.find(_key);
+		if (it == values.end())
+			m_journal.emplace_back(_key, std::nullopt);
+		else
+			m_journal.emplace_back(_key, it->second);
+	}
+
+	size_t m_openSnapshots = 0;
+	/// Keys and their previous values, in the order in which they were changed.
+	std::vector<std::pair<K, std::optional<V>>> m_journal;
 };
 
 template <class T>
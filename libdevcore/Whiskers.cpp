@@ -25,11 +25,240 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+namespace
+{
+
+/// Part of a parsed template. Conditions and lists contain nested sequences of segments.
+struct Segment
+{
+	enum class Kind { Literal, Parameter, Condition, List };
+	Kind kind;
+	/// Literal text or name of the parameter, condition or list.
+	string text;
+	/// Body of a list or the part of a condition used if it is true.
+	vector<Segment> body;
+	/// Part of a condition used if it is false.
+	vector<Segment> elseBody;
+};
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// Parses a parameter name at @a _pos terminated by ">" and returns the position after ">",
+/// or string::npos if there is no valid parameter name.
+size_t parseTagName(string const& _text, size_t _pos, size_t _end, string& _name)
+{
+	size_t nameEnd = _pos;
+	while (nameEnd < _end && isParameterCharacter(_text[nameEnd]))
+		++nameEnd;
+	if (nameEnd == _pos || nameEnd >= _end || _text[nameEnd] != '>')
+		return string::npos;
+	_name = _text.substr(_pos, nameEnd - _pos);
+	return nameEnd + 1;
+}
+
+/// @returns the position of the first occurrence of @a _needle in [_pos, _end) or string::npos.
+size_t find(string const& _text, string const& _needle, size_t _pos, size_t _end)
+{
+	size_t pos = _text.find(_needle, _pos);
+	return (pos == string::npos || pos + _needle.size() > _end) ? string::npos : pos;
+}
+
+/// Parses the range [_begin, _end) of @a _text into segments. The matching rules are
+/// the same as those of the original regular expression: tags are matched from left to
+/// right and conditions and lists end at the first matching closing tag.
+vector<Segment> parseSegments(string const& _text, size_t _begin, size_t _end)
+{
+	vector<Segment> segments;
+	auto appendLiteral = [&](size_t _from, size_t _to)
+	{
+		if (_from == _to)
+			return;
+		if (segments.empty() || segments.back().kind != Segment::Kind::Literal)
+			segments.push_back(Segment{Segment::Kind::Literal, {}, {}, {}});
+		segments.back().text.append(_text, _from, _to - _from);
+	};
+
+	size_t literalStart = _begin;
+	size_t pos = _begin;
+	while (true)
+	{
+		pos = find(_text, "<", pos, _end);
+		if (pos == string::npos)
+			break;
+
+		string name;
+		size_t afterTag = string::npos;
+		optional<Segment> segment;
+		if (pos + 1 < _end && (_text[pos + 1] == '#' || _text[pos + 1] == '?'))
+		{
+			bool isList = _text[pos + 1] == '#';
+			size_t bodyStart = parseTagName(_text, pos + 2, _end, name);
+			if (bodyStart != string::npos)
+			{
+				string closingTag = "</" + name + ">";
+				if (isList)
+				{
+					size_t bodyEnd = find(_text, closingTag, bodyStart, _end);
+					if (bodyEnd != string::npos)
+					{
+						segment = Segment{Segment::Kind::List, name, parseSegments(_text, bodyStart, bodyEnd), {}};
+						afterTag = bodyEnd + closingTag.size();
+					}
+				}
+				else
+				{
+					string elseTag = "<!" + name + ">";
+					for (
+						size_t bodyEnd = find(_text, "<", bodyStart, _end);
+						bodyEnd != string::npos;
+						bodyEnd = find(_text, "<", bodyEnd + 1, _end)
+					)
+					{
+						if (_text.compare(bodyEnd, elseTag.size(), elseTag) == 0)
+						{
+							size_t elseStart = bodyEnd + elseTag.size();
+							size_t elseEnd = find(_text, closingTag, elseStart, _end);
+							if (elseEnd != string::npos)
+							{
+								segment = Segment{
+									Segment::Kind::Condition,
+									name,
+									parseSegments(_text, bodyStart, bodyEnd),
+									parseSegments(_text, elseStart, elseEnd)
+								};
+								afterTag = elseEnd + closingTag.size();
+								break;
+							}
+						}
+						else if (_text.compare(bodyEnd, closingTag.size(), closingTag) == 0)
+						{
+							segment = Segment{Segment::Kind::Condition, name, parseSegments(_text, bodyStart, bodyEnd), {}};
+							afterTag = bodyEnd + closingTag.size();
+							break;
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			afterTag = parseTagName(_text, pos + 1, _end, name);
+			if (afterTag != string::npos)
+				segment = Segment{Segment::Kind::Parameter, name, {}, {}};
+		}
+
+		if (segment)
+		{
+			appendLiteral(literalStart, pos);
+			segments.emplace_back(std::move(*segment));
+			literalStart = pos = afterTag;
+		}
+		else
+			++pos;
+	}
+	appendLiteral(literalStart, _end);
+	return segments;
+}
+
+void renderSegments(
+	vector<Segment> const& _segments,
+	string const& _template,
+	Whiskers::StringMap const& _parameters,
+	Whiskers::StringMap const* _listElement,
+	map<string, bool> const& _conditions,
+	Whiskers::StringListMap const* _listParameters,
+	string& _output
+)
+{
+	for (Segment const& segment: _segments)
+		switch (segment.kind)
+		{
+		case Segment::Kind::Literal:
+			_output += segment.text;
+			break;
+		case Segment::Kind::Parameter:
+		{
+			if (_listElement)
+			{
+				auto value = _listElement->find(segment.text);
+				if (value != _listElement->end())
+				{
+					_output += value->second;
+					break;
+				}
+			}
+			auto value = _parameters.find(segment.text);
+			assertThrow(
+				value != _parameters.end(),
+				WhiskersError,
+				"Value for tag " + segment.text + " not provided.\n" +
+				"Template:\n" +
+				_template
+			);
+			_output += value->second;
+			break;
+		}
+		case Segment::Kind::Condition:
+		{
+			auto condition = _conditions.find(segment.text);
+			assertThrow(
+				condition != _conditions.end(),
+				WhiskersError, "Condition parameter " + segment.text + " not set."
+			);
+			renderSegments(
+				condition->second ? segment.body : segment.elseBody,
+				_template,
+				_parameters,
+				_listElement,
+				_conditions,
+				_listParameters,
+				_output
+			);
+			break;
+		}
+		case Segment::Kind::List:
+		{
+			// Lists cannot be nested, so list parameters are not available inside a list.
+			assertThrow(
+				_listParameters && _listParameters->count(segment.text),
+				WhiskersError, "List parameter " + segment.text + " not set."
+			);
+			for (auto const& element: _listParameters->at(segment.text))
+			{
+				for (auto const& value: element)
+					assertThrow(
+						!_parameters.count(value.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				renderSegments(segment.body, _template, _parameters, &element, _conditions, nullptr, _output);
+			}
+			break;
+		}
+		}
+}
+
+}
+
+struct Whiskers::Template
+{
+	vector<Segment> segments;
+};
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -67,14 +296,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	renderSegments(parse(m_template)->segments, m_template, m_parameters, nullptr, m_conditions, &m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -99,97 +330,15 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Template const> Whiskers::parse(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	static unordered_map<string, shared_ptr<Template const>> cache;
+	auto& parsed = cache[_template];
+	if (!parsed)
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		auto templ = make_shared<Template>();
+		templ->segments = parseSegments(_template, 0, _template.size());
+		parsed = std::move(templ);
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag("<(" + paramRegex() + ")>|<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|<\\?(" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
-			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	return parsed;
 }
-
@@ -25,8 +25,9 @@
 
 #include <libdevcore/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace dev
@@ -62,6 +63,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once per process: the parsed form is cached per template string
+ * and shared between all instances, so rendering is a single pass over the parsed template.
  */
 class Whiskers
 {
@@ -85,22 +89,16 @@ public:
 	std::string render() const;
 
 private:
+	/// Parsed form of a template.
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed form of @a _template, parsing it only if it is not yet cached.
+	static std::shared_ptr<Template const> parse(std::string const& _template);
 
 	std::string m_template;
 	StringMap m_parameters;
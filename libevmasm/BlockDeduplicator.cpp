@@ -26,14 +26,38 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
 #include <functional>
-#include <set>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
 
+namespace
+{
+
+void hashCombine(size_t& _seed, size_t _value)
+{
+	_seed ^= _value + 0x9e3779b97f4a7c15 + (_seed << 6) + (_seed >> 2);
+}
+
+/// @returns a hash of @a _item that is compatible with AssemblyItem::operator==.
+size_t hashItem(AssemblyItem const& _item)
+{
+	size_t hash = size_t(_item.type());
+	if (_item.type() == Operation)
+		hashCombine(hash, size_t(_item.instruction()));
+	else
+		for (u256 value = _item.data(); value != 0; value >>= 64)
+			hashCombine(hash, size_t(uint64_t(value & u256(numeric_limits<uint64_t>::max()))));
+	return hash;
+}
+
+}
+
 bool BlockDeduplicator::deduplicate()
 {
 	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
@@ -48,47 +72,63 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	// @returns the iterator range of the block starting at @a _i. To compare recursive
+	// loops, PushTag opcodes of the block's own tag are replaced by pushSelf.
+	auto blockRange = [&](size_t _i, AssemblyItem& _pushOwnTag)
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
+		_pushOwnTag = pushSelf;
 		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		BlockIterator first{m_items.begin() + _i, m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + _j, m_items.end(), &pushSecondTag, &pushSelf};
+			_pushOwnTag = m_items.at(_i).pushTag();
+		BlockIterator begin{m_items.begin() + ptrdiff_t(_i), m_items.end(), &_pushOwnTag, &pushSelf};
 		BlockIterator end{m_items.end(), m_items.end()};
+		if (begin != end && (*begin).type() == Tag)
+			++begin;
+		return make_pair(begin, end);
+	};
 
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
+	auto hashBlock = [&](size_t _i)
+	{
+		AssemblyItem pushOwnTag{pushSelf};
+		auto [begin, end] = blockRange(_i, pushOwnTag);
+		size_t hash = 0;
+		for (auto it = begin; it != end; ++it)
+			hashCombine(hash, hashItem(*it));
+		return hash;
+	};
 
-		return std::lexicographical_compare(first, end, second, end);
+	auto equalBlocks = [&](size_t _i, size_t _j)
+	{
+		AssemblyItem pushFirstTag{pushSelf};
+		AssemblyItem pushSecondTag{pushSelf};
+		auto [firstBegin, firstEnd] = blockRange(_i, pushFirstTag);
+		auto [secondBegin, secondEnd] = blockRange(_j, pushSecondTag);
+		for (; firstBegin != firstEnd && secondBegin != secondEnd; ++firstBegin, ++secondBegin)
+			if (*firstBegin != *secondBegin)
+				return false;
+		return firstBegin == firstEnd && secondBegin == secondEnd;
 	};
 
+	// Replacing tags can make further blocks equal, so this is repeated until nothing changes.
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Blocks seen so far by hash, in the order of their position.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[hashBlock(i)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) { return equalBlocks(_j, i); });
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+			{
+				u256 const& tag = m_items.at(i).data();
+				if (!m_replacedTags.count(tag))
+					m_deduplicatedBytes += blockSize(i);
+				m_replacedTags[tag] = m_items.at(*it).data();
+			}
 		}
 
 		if (!applyTagReplacement(m_items, m_replacedTags))
@@ -97,6 +137,18 @@ bool BlockDeduplicator::deduplicate()
 	return iterations > 0;
 }
 
+size_t BlockDeduplicator::blockSize(size_t _tagPosition) const
+{
+	size_t size = m_items.at(_tagPosition).bytesRequired(3);
+	for (size_t i = _tagPosition + 1; i < m_items.size() && m_items.at(i).type() != Tag; ++i)
+	{
+		size += m_items.at(i).bytesRequired(3); // assume 3 byte addresses
+		if (SemanticInformation::altersControlFlow(m_items.at(i)) && m_items.at(i) != Instruction::JUMPI)
+			break;
+	}
+	return size;
+}
+
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
@@ -50,6 +50,11 @@ public:
 	bool deduplicate();
 	/// @returns the tags that were replaced.
 	std::map<u256, u256> const& replacedTags() const { return m_replacedTags; }
+	/// @returns the number of bytes in the blocks whose tags were replaced, up to the
+	/// next tag or the end of the block. The code of these blocks is removed by later steps
+	/// unless it is still reached by falling through from a previous block.
+	/// Not part of any compiler output, meant for tools that measure the optimiser.
+	size_t deduplicatedBytes() const { return m_deduplicatedBytes; }
 
 	/// Replaces all PushTag operations insied @a _items that match a key in
 	/// @a _replacements by the respective value. If @a _subID is not -1, only
@@ -62,6 +67,10 @@ public:
 	);
 
 private:
+	/// @returns the number of bytes of the code between the tag at @a _tagPosition and the
+	/// next tag or the end of the block.
+	size_t blockSize(size_t _tagPosition) const;
+
 	/// Iterator that skips tags and skips to the end if (all branches of) the control
 	/// flow does not continue to the next instruction.
 	/// If the arguments are supplied to the constructor, replaces items on the fly.
@@ -86,6 +95,7 @@ private:
 	};
 
 	std::map<u256, u256> m_replacedTags;
+	size_t m_deduplicatedBytes = 0;
 	AssemblyItems& m_items;
 };
 
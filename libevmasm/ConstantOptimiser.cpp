@@ -22,10 +22,32 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+
+#include <tuple>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+using ComputeMethodCacheKey = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+
+/// The same constants (masks, selectors, powers of two) appear in most contracts, so the
+/// representations found by ComputeMethod are shared between all assemblies compiled by
+/// this thread. They only depend on the value and on the parameters that go into the
+/// gas estimate. The cache is dropped once it reaches its maximum size.
+map<ComputeMethodCacheKey, AssemblyItems>& computeMethodCache()
+{
+	thread_local map<ComputeMethodCacheKey, AssemblyItems> cache;
+	return cache;
+}
+
+size_t const c_maxComputeMethodCacheSize = 0x1000;
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -185,6 +207,33 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	auto& cache = computeMethodCache();
+	ComputeMethodCacheKey key{_value, _params.isCreation, _params.runs, _params.multiplicity, _params.evmVersion};
+	if (auto cached = cache.find(key); cached != cache.end())
+	{
+		m_routine = cached->second;
+		return;
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+	if (cache.size() >= c_maxComputeMethodCacheSize)
+		cache.clear();
+	cache.emplace(move(key), m_routine);
+}
+
+void ComputeMethod::clearCache()
+{
+	computeMethodCache().clear();
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
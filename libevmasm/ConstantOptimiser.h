@@ -134,16 +134,12 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	/// Finds a representation of @a _value or takes it from the cache of representations
+	/// found for the same value and parameters before by the current thread.
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
+
+	/// Clears the cache of representations of the current thread.
+	static void clearCache();
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
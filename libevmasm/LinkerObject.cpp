@@ -36,13 +36,14 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
-	std::map<size_t, std::string> remainingRefs;
-	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
-			copy(address->data(), address->data() + 20, bytecode.begin() + linkRef.first);
+	for (auto linkRef = linkReferences.begin(); linkRef != linkReferences.end();)
+		if (h160 const* address = matchLibrary(linkRef->second, _libraryAddresses))
+		{
+			copy(address->data(), address->data() + 20, bytecode.begin() + ptrdiff_t(linkRef->first));
+			linkRef = linkReferences.erase(linkRef);
+		}
 		else
-			remainingRefs.insert(linkRef);
-	linkReferences.swap(remainingRefs);
+			++linkRef;
 }
 
 string LinkerObject::toHex() const
@@ -20,9 +20,15 @@
 
 #pragma once
 
+#include <libevmasm/Exceptions.h>
 #include <libevmasm/Instruction.h>
+#include <libdevcore/Assertions.h>
 #include <libdevcore/CommonData.h>
+#include <algorithm>
+#include <bitset>
 #include <functional>
+#include <map>
+#include <vector>
 
 namespace dev
 {
@@ -56,6 +62,151 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/**
+ * Summary of the outermost item of an expression or of what a pattern requires of it:
+ * anything (or, for expressions, something that is neither a constant nor an instruction),
+ * a constant (possibly with a specific value) or a specific instruction.
+ */
+struct MatchKey
+{
+	enum class Kind { Any, Constant, Operation };
+
+	static MatchKey any() { return MatchKey{}; }
+	static MatchKey constant() { MatchKey key; key.kind = Kind::Constant; return key; }
+	static MatchKey constant(u256 const& _value)
+	{
+		MatchKey key = constant();
+		key.hasValue = true;
+		key.value = _value;
+		return key;
+	}
+	static MatchKey operation(Instruction _instruction)
+	{
+		MatchKey key;
+		key.kind = Kind::Operation;
+		key.instruction = _instruction;
+		return key;
+	}
+
+	Kind kind = Kind::Any;
+	bool hasValue = false;
+	u256 value; ///< Only valid if kind is Constant and hasValue is set.
+	Instruction instruction = Instruction::STOP; ///< Only valid if kind is Operation.
+};
+
+/**
+ * The simplification rules for a single instruction, indexed by what their patterns require
+ * of the outermost item of each argument.
+ * Finding a match only tries the rules that are compatible with the outermost items of all
+ * arguments of the expression, which is determined by a few lookups and bitset intersections
+ * instead of trying every rule. The remaining candidates are tried in the order the rules were
+ * added, so the priority among rules is unchanged.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	static size_t constexpr MaxRules = 512;
+
+	void add(SimplificationRule<Pattern> _rule)
+	{
+		size_t ruleIndex = m_rules.size();
+		assertThrow(ruleIndex < MaxRules, OptimizerException, "Too many rules for one instruction.");
+		std::vector<Pattern> arguments = _rule.pattern.arguments();
+		if (m_arguments.size() < arguments.size())
+			// Earlier rules do not restrict the new positions.
+			m_arguments.resize(arguments.size(), ArgumentIndex{m_allRules, {}, {}, {}});
+		for (size_t i = 0; i < m_arguments.size(); ++i)
+		{
+			ArgumentIndex& argument = m_arguments[i];
+			MatchKey key = i < arguments.size() ? arguments[i].matchKey() : MatchKey::any();
+			switch (key.kind)
+			{
+			case MatchKey::Kind::Any:
+				argument.any.set(ruleIndex);
+				break;
+			case MatchKey::Kind::Constant:
+				if (key.hasValue)
+					argument.constants[key.value].set(ruleIndex);
+				else
+					argument.anyConstant.set(ruleIndex);
+				break;
+			case MatchKey::Kind::Operation:
+				argument.operations[key.instruction].set(ruleIndex);
+				break;
+			}
+		}
+		m_allRules.set(ruleIndex);
+		m_rules.emplace_back(std::move(_rule));
+	}
+
+	bool empty() const { return m_rules.empty(); }
+
+	/// @returns the first rule, in the order of addition, that is compatible with the keys of the
+	/// arguments and for which @a _matches returns true.
+	/// @param _keyOf function returning the MatchKey of the argument at the given position.
+	template <class KeyOf, class Matches>
+	SimplificationRule<Pattern> const* findFirst(
+		size_t _argumentCount,
+		KeyOf const& _keyOf,
+		Matches const& _matches
+	) const
+	{
+		RuleSet candidates = m_allRules;
+		for (size_t i = 0; i < std::min(_argumentCount, m_arguments.size()) && candidates.any(); ++i)
+			candidates &= m_arguments[i].compatibleRules(_keyOf(i));
+		for (size_t i = 0; i < m_rules.size() && candidates.any(); ++i)
+			if (candidates.test(i))
+			{
+				if (_matches(m_rules[i]))
+					return &m_rules[i];
+				candidates.reset(i);
+			}
+		return nullptr;
+	}
+
+private:
+	using RuleSet = std::bitset<MaxRules>;
+
+	struct ArgumentIndex
+	{
+		RuleSet compatibleRules(MatchKey const& _key) const
+		{
+			RuleSet result = any;
+			if (_key.kind == MatchKey::Kind::Constant)
+			{
+				result |= anyConstant;
+				if (_key.hasValue)
+				{
+					auto it = constants.find(_key.value);
+					if (it != constants.end())
+						result |= it->second;
+				}
+			}
+			else if (_key.kind == MatchKey::Kind::Operation)
+			{
+				auto it = operations.find(_key.instruction);
+				if (it != operations.end())
+					result |= it->second;
+			}
+			return result;
+		}
+
+		/// Rules that accept anything at this position.
+		RuleSet any;
+		/// Rules that require a constant of any value at this position.
+		RuleSet anyConstant;
+		/// Rules that require a specific constant at this position.
+		std::map<u256, RuleSet> constants;
+		/// Rules that require a specific instruction at this position.
+		std::map<Instruction, RuleSet> operations;
+	};
+
+	std::vector<SimplificationRule<Pattern>> m_rules;
+	RuleSet m_allRules;
+	std::vector<ArgumentIndex> m_arguments;
+};
+
 template <typename Pattern>
 struct EVMBuiltins
 {
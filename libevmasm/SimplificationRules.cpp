@@ -45,18 +45,15 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	ExpressionClasses const& _classes
 )
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
-	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-
-		resetMatchGroups();
-	}
-	return nullptr;
+	return m_rules[uint8_t(_expr.item->instruction())].findFirst(
+		_expr.arguments.size(),
+		[&](size_t _index) { return matchKey(_classes.representative(_expr.arguments[_index])); },
+		[&](SimplificationRule<Pattern> const& _rule) {
+			resetMatchGroups();
+			return _rule.pattern.matches(_expr, _classes) && (!_rule.feasible || _rule.feasible());
+		}
+	);
 }
 
 bool Rules::isInitialized() const
@@ -72,7 +69,18 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules[uint8_t(_rule.pattern.instruction())].add(_rule);
+}
+
+MatchKey Rules::matchKey(Expression const& _expr)
+{
+	if (!_expr.item)
+		return MatchKey::any();
+	else if (_expr.item->type() == Push)
+		return MatchKey::constant(_expr.item->data());
+	else if (_expr.item->type() == Operation)
+		return MatchKey::operation(_expr.item->instruction());
+	return MatchKey::any();
 }
 
 Rules::Rules()
@@ -106,8 +114,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	assertThrow(0 < _group && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -118,7 +127,7 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
+		if (!(*m_matchGroups)[m_matchGroup])
 			(*m_matchGroups)[m_matchGroup] = &_expr;
 		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
 			return false;
@@ -130,6 +139,16 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+MatchKey Pattern::matchKey() const
+{
+	if (m_type == Push)
+		return m_requireDataMatch ? MatchKey::constant(data()) : MatchKey::constant();
+	else if (m_type == Operation)
+		return MatchKey::operation(m_instruction);
+	// Other item types are not indexed, they are checked by the full match.
+	return MatchKey::any();
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
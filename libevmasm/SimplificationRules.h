@@ -30,6 +30,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
 #include <functional>
 #include <vector>
 
@@ -45,6 +46,10 @@ namespace eth
 
 class Pattern;
 
+/// Expressions matched by the patterns of the match groups, indexed by match group.
+/// Index zero is unused, since it denotes "no match group".
+using MatchGroups = std::array<ExpressionClasses::Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
  */
@@ -70,12 +75,14 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	static MatchKey matchKey(Expression const& _expr);
+
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	MatchGroups m_matchGroups{};
 	/// Pattern to match, replacement to be applied and flag indicating whether
-	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	/// the replacement might remove some elements (except constants), per instruction.
+	SimplificationRuleIndex<Pattern> m_rules[256];
 };
 
 /**
@@ -106,12 +113,14 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	/// @returns what this pattern requires of the outermost item of an expression.
+	MatchKey matchKey() const;
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
@@ -138,7 +147,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 /**
@@ -26,6 +26,8 @@
 #include <libsolidity/ast/Types.h>
 #include <libdevcore/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
@@ -39,10 +41,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(*_name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(*_name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -82,13 +84,15 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& declarations = m_declarations[_name];
+	solAssert(declarations.empty(), "");
+	declarations.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -126,14 +130,28 @@ bool DeclarationContainer::registerDeclaration(
 vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive, bool _alsoInvisible) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
-	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
-	return result;
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+	{
+		vector<Declaration const*> result;
+		if (auto it = container->m_declarations.find(_name); it != container->m_declarations.end())
+			result = it->second;
+		if (_alsoInvisible)
+			if (auto it = container->m_invisibleDeclarations.find(_name); it != container->m_invisibleDeclarations.end())
+				result += it->second;
+		if (!result.empty() || !_recursive)
+			return result;
+	}
+	return {};
+}
+
+vector<pair<ASTString const, vector<Declaration const*>> const*> DeclarationContainer::sortedDeclarations() const
+{
+	vector<pair<ASTString const, vector<Declaration const*>> const*> sorted;
+	sorted.reserve(m_declarations.size());
+	for (auto const& nameAndDeclarations: m_declarations)
+		sorted.push_back(&nameAndDeclarations);
+	sort(sorted.begin(), sorted.end(), [](auto const* _a, auto const* _b) { return _a->first < _b->first; });
+	return sorted;
 }
 
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
@@ -143,20 +161,23 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 	// since 80 is the suggested line length limit, we use 80^2 as length threshold
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
 
-	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
+	auto findSimilar = [&](unordered_map<ASTString, vector<Declaration const*>> const& _declarations)
 	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
+		vector<ASTString> similar;
+		for (auto const& declaration: _declarations)
+		{
+			string const& declarationName = declaration.first;
+			if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similar.push_back(declarationName);
+		}
+		// Sorted to keep the suggestions independent of the hash order.
+		sort(similar.begin(), similar.end());
+		return similar;
+	};
+
+	vector<ASTString> similar = findSimilar(m_declarations);
+	similar += findSimilar(m_invisibleDeclarations);
 
 	if (m_enclosingContainer)
 		similar += m_enclosingContainer->similarNames(_name);
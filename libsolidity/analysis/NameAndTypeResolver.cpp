@@ -39,7 +39,7 @@ namespace solidity
 NameAndTypeResolver::NameAndTypeResolver(
 	GlobalContext& _globalContext,
 	langutil::EVMVersion _evmVersion,
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ErrorReporter& _errorReporter
 ):
 	m_scopes(_scopes),
@@ -116,10 +116,10 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 								error = true;
 				}
 			else if (imp->name().empty())
-				for (auto const& nameAndDeclaration: scope->second->declarations())
-					for (auto const& declaration: nameAndDeclaration.second)
+				for (auto const* nameAndDeclaration: scope->second->sortedDeclarations())
+					for (auto const& declaration: nameAndDeclaration->second)
 						if (!DeclarationRegistrationHelper::registerDeclaration(
-							target, *declaration, &nameAndDeclaration.first, &imp->location(), true, false, m_errorReporter
+							target, *declaration, &nameAndDeclaration->first, &imp->location(), true, false, m_errorReporter
 						))
 							error =  true;
 		}
@@ -334,8 +334,8 @@ void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
-	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
+	for (auto const* nameAndDeclaration: iterator->second->sortedDeclarations())
+		for (auto const& declaration: nameAndDeclaration->second)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
 				if (!m_currentScope->registerDeclaration(*declaration))
@@ -456,7 +456,7 @@ string NameAndTypeResolver::similarNameSuggestions(ASTString const& _name) const
 }
 
 DeclarationRegistrationHelper::DeclarationRegistrationHelper(
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ASTNode& _astRoot,
 	ErrorReporter& _errorReporter,
 	GlobalContext& _globalContext,
@@ -552,7 +552,8 @@ bool DeclarationRegistrationHelper::visit(SourceUnit& _sourceUnit)
 
 void DeclarationRegistrationHelper::endVisit(SourceUnit& _sourceUnit)
 {
-	_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+	auto const& declarations = m_scopes[&_sourceUnit]->declarations();
+	_sourceUnit.annotation().exportedSymbols = {declarations.begin(), declarations.end()};
 	closeCurrentScope();
 }
 
@@ -703,7 +704,7 @@ void DeclarationRegistrationHelper::endVisit(EventDefinition&)
 
 void DeclarationRegistrationHelper::enterNewSubScope(ASTNode& _subScope)
 {
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
 	bool newlyAdded;
 	shared_ptr<DeclarationContainer> container{make_shared<DeclarationContainer>(m_currentScope, m_scopes[m_currentScope].get())};
 	tie(iter, newlyAdded) = m_scopes.emplace(&_subScope, move(container));
@@ -34,6 +34,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 namespace langutil
 {
@@ -58,7 +59,7 @@ public:
 	NameAndTypeResolver(
 		GlobalContext& _globalContext,
 		langutil::EVMVersion _evmVersion,
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		langutil::ErrorReporter& _errorReporter
 	);
 	/// Registers all declarations found in the AST node, usually a source unit.
@@ -131,7 +132,7 @@ private:
 	/// where nullptr denotes the global scope. Note that structs are not scope since they do
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 
 	langutil::EVMVersion m_evmVersion;
 	DeclarationContainer* m_currentScope = nullptr;
@@ -151,7 +152,7 @@ public:
 	/// @param _currentScope should be nullptr if we start at SourceUnit, but can be different
 	/// to inject new declarations into an existing scope, used by snippets.
 	DeclarationRegistrationHelper(
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		ASTNode& _astRoot,
 		langutil::ErrorReporter& _errorReporter,
 		GlobalContext& _globalContext,
@@ -203,7 +204,7 @@ private:
 	/// @returns the canonical name of the current scope.
 	std::string currentCanonicalName() const;
 
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 	ASTNode const* m_currentScope = nullptr;
 	VariableScope* m_currentFunction = nullptr;
 	langutil::ErrorReporter& m_errorReporter;
@@ -30,6 +30,8 @@
 #include <boost/algorithm/string.hpp>
 #include <algorithm>
 #include <functional>
+#include <string_view>
+#include <unordered_set>
 
 using namespace std;
 using namespace dev;
@@ -187,33 +189,41 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 {
 	if (!m_interfaceFunctionList)
 	{
-		set<string> signaturesSeen;
+		// The views refer to the signatures cached in the base contracts.
+		unordered_set<string_view> signaturesSeen;
 		m_interfaceFunctionList = make_unique<vector<pair<FixedHash<4>, FunctionTypePointer>>>();
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
+			for (InterfaceFunction const& fun: contract->definedInterfaceFunctions())
+				if (signaturesSeen.insert(fun.signature).second)
+					m_interfaceFunctionList->emplace_back(fun.selector, fun.type);
+	}
+	return *m_interfaceFunctionList;
+}
+
+vector<ContractDefinition::InterfaceFunction> const& ContractDefinition::definedInterfaceFunctions() const
+{
+	if (!m_definedInterfaceFunctions)
+	{
+		vector<FunctionTypePointer> functions;
+		for (FunctionDefinition const* f: definedFunctions())
+			if (f->isPartOfExternalInterface())
+				functions.push_back(TypeProvider::function(*f, false));
+		for (VariableDeclaration const* v: stateVariables())
+			if (v->isPartOfExternalInterface())
+				functions.push_back(TypeProvider::function(*v));
+
+		m_definedInterfaceFunctions = make_unique<vector<InterfaceFunction>>();
+		for (FunctionTypePointer const& fun: functions)
 		{
-			vector<FunctionTypePointer> functions;
-			for (FunctionDefinition const* f: contract->definedFunctions())
-				if (f->isPartOfExternalInterface())
-					functions.push_back(TypeProvider::function(*f, false));
-			for (VariableDeclaration const* v: contract->stateVariables())
-				if (v->isPartOfExternalInterface())
-					functions.push_back(TypeProvider::function(*v));
-			for (FunctionTypePointer const& fun: functions)
-			{
-				if (!fun->interfaceFunctionType())
-					// Fails hopefully because we already registered the error
-					continue;
-				string functionSignature = fun->externalSignature();
-				if (signaturesSeen.count(functionSignature) == 0)
-				{
-					signaturesSeen.insert(functionSignature);
-					FixedHash<4> hash(dev::keccak256(functionSignature));
-					m_interfaceFunctionList->emplace_back(hash, fun);
-				}
-			}
+			if (!fun->interfaceFunctionType())
+				// Fails hopefully because we already registered the error
+				continue;
+			string functionSignature = fun->externalSignature();
+			FixedHash<4> hash(dev::keccak256(functionSignature));
+			m_definedInterfaceFunctions->push_back({move(functionSignature), hash, fun});
 		}
 	}
-	return *m_interfaceFunctionList;
+	return *m_definedInterfaceFunctions;
 }
 
 vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
@@ -442,10 +442,24 @@ public:
 	ContractKind contractKind() const { return m_contractKind; }
 
 private:
+	/// Function or public state variable that is part of the external interface.
+	struct InterfaceFunction
+	{
+		std::string signature;
+		FixedHash<4> selector;
+		FunctionTypePointer type;
+	};
+
+	/// @returns the interface functions defined in this contract, excluding inherited ones.
+	/// Derived contracts assemble their interface from these lists, so signatures and
+	/// selectors are computed only once per function across an inheritance hierarchy.
+	std::vector<InterfaceFunction> const& definedInterfaceFunctions() const;
+
 	std::vector<ASTPointer<InheritanceSpecifier>> m_baseContracts;
 	std::vector<ASTPointer<ASTNode>> m_subNodes;
 	ContractKind m_contractKind;
 
+	mutable std::unique_ptr<std::vector<InterfaceFunction>> m_definedInterfaceFunctions;
 	mutable std::unique_ptr<std::vector<std::pair<FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList;
 	mutable std::unique_ptr<std::vector<EventDefinition const*>> m_interfaceEvents;
 	mutable std::unique_ptr<std::vector<Declaration const*>> m_inheritableMembers;
@@ -49,34 +49,40 @@ ASTJsonConverter::ASTJsonConverter(bool _legacy, map<string, unsigned> _sourceIn
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeName,
-	initializer_list<pair<string, Json::Value>>&& _attributes
+	initializer_list<pair<string, AttributeValue>>&& _attributes
 )
 {
 	ASTJsonConverter::setJsonNode(
 		_node,
 		_nodeName,
-		std::vector<pair<string, Json::Value>>(std::move(_attributes))
+		Attributes(std::move(_attributes))
 	);
 }
 
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeType,
-	std::vector<pair<string, Json::Value>>&& _attributes
+	Attributes&& _attributes
 )
 {
-	m_currentValue = Json::objectValue;
-	m_currentValue["id"] = nodeId(_node);
-	m_currentValue["src"] = sourceLocationToString(_node.location());
+	if (m_stream)
+	{
+		writeJsonNode(_node, _nodeType, std::move(_attributes));
+		return;
+	}
+
+	Json::Value node = Json::objectValue;
+	node["id"] = nodeId(_node);
+	node["src"] = sourceLocationToString(_node.location());
 	if (!m_legacy)
 	{
-		m_currentValue["nodeType"] = _nodeType;
+		node["nodeType"] = _nodeType;
 		for (auto& e: _attributes)
-			m_currentValue[e.first] = std::move(e.second);
+			node[e.first] = toJson(std::move(e.second));
 	}
 	else
 	{
-		m_currentValue["name"] = _nodeType;
+		node["name"] = _nodeType;
 		Json::Value attrs(Json::objectValue);
 		if (
 			//these nodeTypes need to have a children-node even if it is empty
@@ -86,10 +92,11 @@ void ASTJsonConverter::setJsonNode(
 			(_nodeType == "InlineAssembly") ||
 			(_nodeType == "Throw")
 		)
-			m_currentValue["children"] = Json::arrayValue;
+			node["children"] = Json::arrayValue;
 
-		for (auto& e: _attributes)
+		for (auto& attribute: _attributes)
 		{
+			pair<string, Json::Value> e{attribute.first, toJson(std::move(attribute.second))};
 			if ((!e.second.isNull()) && (
 				(e.second.isObject() && e.second.isMember("name")) ||
 				(e.second.isArray() && e.second[0].isObject() && e.second[0].isMember("name")) ||
@@ -98,17 +105,17 @@ void ASTJsonConverter::setJsonNode(
 			{
 				if (e.second.isObject())
 				{
-					if (!m_currentValue["children"].isArray())
-						m_currentValue["children"] = Json::arrayValue;
-					appendMove(m_currentValue["children"], std::move(e.second));
+					if (!node["children"].isArray())
+						node["children"] = Json::arrayValue;
+					appendMove(node["children"], std::move(e.second));
 				}
 				if (e.second.isArray())
 					for (auto& child: e.second)
 						if (!child.isNull())
 						{
-							if (!m_currentValue["children"].isArray())
-								m_currentValue["children"] = Json::arrayValue;
-							appendMove(m_currentValue["children"], std::move(child));
+							if (!node["children"].isArray())
+								node["children"] = Json::arrayValue;
+							appendMove(node["children"], std::move(child));
 						}
 			}
 			else
@@ -120,8 +127,198 @@ void ASTJsonConverter::setJsonNode(
 			}
 		}
 		if (!attrs.empty())
-			m_currentValue["attributes"] = std::move(attrs);
+			node["attributes"] = std::move(attrs);
+	}
+	m_currentValue = std::move(node);
+}
+
+void ASTJsonConverter::writeJsonNode(
+	ASTNode const& _node,
+	string const& _nodeType,
+	Attributes&& _attributes
+)
+{
+	if (m_legacy)
+	{
+		writeLegacyJsonNode(_node, _nodeType, std::move(_attributes));
+		return;
+	}
+
+	_attributes.emplace_back("id", nodeId(_node));
+	_attributes.emplace_back("src", sourceLocationToString(_node.location()));
+	_attributes.emplace_back("nodeType", _nodeType);
+
+	// Members have to be written in the order jsoncpp sorts object keys. If a key is
+	// used more than once, the last value wins.
+	vector<pair<string, AttributeValue>*> members;
+	for (auto& e: _attributes)
+		members.push_back(&e);
+	stable_sort(members.begin(), members.end(), [](auto const* _a, auto const* _b) { return _a->first < _b->first; });
+
+	*m_stream << "{";
+	bool first = true;
+	for (size_t i = 0; i < members.size(); ++i)
+	{
+		if (i + 1 < members.size() && members[i]->first == members[i + 1]->first)
+			continue;
+		// Attribute names never require escaping.
+		*m_stream << (first ? "\"" : ",\"") << members[i]->first << "\":";
+		first = false;
+		write(members[i]->second);
 	}
+	*m_stream << "}";
+}
+
+void ASTJsonConverter::writeLegacyJsonNode(
+	ASTNode const& _node,
+	string const& _nodeType,
+	Attributes&& _attributes
+)
+{
+	// This has to produce the same output as the legacy branch of setJsonNode, including
+	// its quirks: Empty lists are turned into [null] and a list only counts as children
+	// if its first element is a node.
+	auto isChild = [](string const& _key, AttributeValue const& _value)
+	{
+		if (_value.isNodeList)
+			return (!_value.nodes.empty() && _value.nodes.front()) || _key == "declarations";
+		if (!_value.nodes.empty())
+			return true;
+		Json::Value const& json = _value.json;
+		if (json.isNull())
+			return false;
+		return
+			(json.isObject() && json.isMember("name")) ||
+			(json.isArray() && !json.empty() && json[0].isObject() && json[0].isMember("name")) ||
+			_key == "declarations";
+	};
+
+	bool hasChildren =
+		_nodeType == "VariableDeclaration" ||
+		_nodeType == "ParameterList" ||
+		_nodeType == "Block" ||
+		_nodeType == "InlineAssembly" ||
+		_nodeType == "Throw";
+	vector<AttributeValue const*> children;
+	vector<pair<string, AttributeValue const*>> attributes;
+	for (auto& [key, value]: _attributes)
+		if (isChild(key, value))
+		{
+			children.push_back(&value);
+			if (value.isNodeList)
+				hasChildren = hasChildren || any_of(value.nodes.begin(), value.nodes.end(), [](auto _n) { return _n; });
+			else if (value.json.isArray())
+				hasChildren = hasChildren || any_of(value.json.begin(), value.json.end(), [](auto const& _e) { return !_e.isNull(); });
+			else
+				hasChildren = true;
+		}
+		else if (key == "typeDescriptions")
+		{
+			value.json = Json::Value(value.json["typeString"]);
+			attributes.emplace_back("type", &value);
+		}
+		else
+			attributes.emplace_back(key, &value);
+
+	*m_stream << "{";
+	if (!attributes.empty())
+	{
+		// Keys are sorted as by jsoncpp. If a key is used more than once, the last value wins.
+		stable_sort(attributes.begin(), attributes.end(), [](auto const& _a, auto const& _b) { return _a.first < _b.first; });
+		*m_stream << "\"attributes\":{";
+		bool first = true;
+		for (size_t i = 0; i < attributes.size(); ++i)
+		{
+			if (i + 1 < attributes.size() && attributes[i].first == attributes[i + 1].first)
+				continue;
+			*m_stream << (first ? "\"" : ",\"") << attributes[i].first << "\":";
+			first = false;
+			AttributeValue const& value = *attributes[i].second;
+			if ((value.isNodeList && value.nodes.empty()) || (value.json.isArray() && value.json.empty()))
+				*m_stream << "[null]";
+			else
+				write(value);
+		}
+		*m_stream << "},";
+	}
+	if (hasChildren)
+	{
+		*m_stream << "\"children\":[";
+		bool first = true;
+		auto separate = [&]() { *m_stream << (first ? "" : ","); first = false; };
+		for (AttributeValue const* value: children)
+			if (value->isNodeList || !value->nodes.empty())
+			{
+				for (ASTNode const* node: value->nodes)
+					if (node)
+					{
+						separate();
+						node->accept(*this);
+					}
+			}
+			else if (value->json.isArray())
+			{
+				for (auto const& element: value->json)
+					if (!element.isNull())
+					{
+						separate();
+						jsonCompactPrint(element, *m_stream);
+					}
+			}
+			else
+			{
+				separate();
+				jsonCompactPrint(value->json, *m_stream);
+			}
+		*m_stream << "],";
+	}
+	*m_stream << "\"id\":";
+	jsonCompactPrint(Json::Value(nodeId(_node)), *m_stream);
+	*m_stream << ",\"name\":";
+	jsonCompactPrint(Json::Value(_nodeType), *m_stream);
+	*m_stream << ",\"src\":";
+	jsonCompactPrint(Json::Value(sourceLocationToString(_node.location())), *m_stream);
+	*m_stream << "}";
+}
+
+Json::Value ASTJsonConverter::toJson(AttributeValue&& _value)
+{
+	if (_value.isNodeList)
+	{
+		Json::Value ret(Json::arrayValue);
+		for (ASTNode const* node: _value.nodes)
+			if (node)
+				appendMove(ret, toJson(*node));
+			else
+				ret.append(Json::nullValue);
+		return ret;
+	}
+	else if (!_value.nodes.empty())
+		return toJson(*_value.nodes.front());
+	else
+		return std::move(_value.json);
+}
+
+void ASTJsonConverter::write(AttributeValue const& _value)
+{
+	if (_value.isNodeList)
+	{
+		*m_stream << "[";
+		for (size_t i = 0; i < _value.nodes.size(); ++i)
+		{
+			if (i > 0)
+				*m_stream << ",";
+			if (_value.nodes[i])
+				_value.nodes[i]->accept(*this);
+			else
+				*m_stream << "null";
+		}
+		*m_stream << "]";
+	}
+	else if (!_value.nodes.empty())
+		_value.nodes.front()->accept(*this);
+	else
+		jsonCompactPrint(_value.json, *m_stream);
 }
 
 string ASTJsonConverter::sourceLocationToString(SourceLocation const& _location) const
@@ -162,11 +359,11 @@ Json::Value ASTJsonConverter::typePointerToJson(std::optional<FuncCallArguments>
 }
 
 void ASTJsonConverter::appendExpressionAttributes(
-	std::vector<pair<string, Json::Value>>& _attributes,
+	Attributes& _attributes,
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<pair<string, Json::Value>> exprAttributes = {
+	Attributes exprAttributes = {
 		make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
 		make_pair("isConstant", _annotation.isConstant),
 		make_pair("isPure", _annotation.isPure),
@@ -193,6 +390,14 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 	_stream << jsonPrettyPrint(toJson(_node));
 }
 
+void ASTJsonConverter::printCompact(ostream& _stream, ASTNode const& _node)
+{
+	solAssert(!m_stream, "");
+	m_stream = &_stream;
+	ScopeGuard resetStream([&]() { m_stream = nullptr; });
+	_node.accept(*this);
+}
+
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
 {
 	_node.accept(*this);
@@ -214,7 +419,7 @@ bool ASTJsonConverter::visit(SourceUnit const& _node)
 		{
 			make_pair("absolutePath", _node.annotation().path),
 			make_pair("exportedSymbols", move(exportedSymbols)),
-			make_pair("nodes", toJson(_node.nodes()))
+			make_pair("nodes", children(_node.nodes()))
 		}
 	);
 	return false;
@@ -233,7 +438,7 @@ bool ASTJsonConverter::visit(PragmaDirective const& _node)
 
 bool ASTJsonConverter::visit(ImportDirective const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("file", _node.path()),
 		make_pair("absolutePath", _node.annotation().absolutePath),
 		make_pair(m_legacy ? "SourceUnit" : "sourceUnit", nodeId(*_node.annotation().sourceUnit)),
@@ -262,9 +467,9 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("contractKind", contractKind(_node.contractKind())),
 		make_pair("fullyImplemented", _node.annotation().unimplementedFunctions.empty()),
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
-		make_pair("baseContracts", toJson(_node.baseContracts())),
+		make_pair("baseContracts", children(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies, true)),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", children(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
 	return false;
@@ -273,8 +478,8 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 bool ASTJsonConverter::visit(InheritanceSpecifier const& _node)
 {
 	setJsonNode(_node, "InheritanceSpecifier", {
-		make_pair("baseName", toJson(_node.name())),
-		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+		make_pair("baseName", child(_node.name())),
+		make_pair("arguments", _node.arguments() ? children(*_node.arguments()) : Json::nullValue)
 	});
 	return false;
 }
@@ -282,8 +487,8 @@ bool ASTJsonConverter::visit(InheritanceSpecifier const& _node)
 bool ASTJsonConverter::visit(UsingForDirective const& _node)
 {
 	setJsonNode(_node, "UsingForDirective", {
-		make_pair("libraryName", toJson(_node.libraryName())),
-		make_pair("typeName", _node.typeName() ? toJson(*_node.typeName()) : Json::nullValue)
+		make_pair("libraryName", child(_node.libraryName())),
+		make_pair("typeName", _node.typeName() ? child(*_node.typeName()) : Json::nullValue)
 	});
 	return false;
 }
@@ -294,7 +499,7 @@ bool ASTJsonConverter::visit(StructDefinition const& _node)
 		make_pair("name", _node.name()),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("canonicalName", _node.annotation().canonicalName),
-		make_pair("members", toJson(_node.members())),
+		make_pair("members", children(_node.members())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
 	return false;
@@ -305,7 +510,7 @@ bool ASTJsonConverter::visit(EnumDefinition const& _node)
 	setJsonNode(_node, "EnumDefinition", {
 		make_pair("name", _node.name()),
 		make_pair("canonicalName", _node.annotation().canonicalName),
-		make_pair("members", toJson(_node.members()))
+		make_pair("members", children(_node.members()))
 	});
 	return false;
 }
@@ -321,24 +526,24 @@ bool ASTJsonConverter::visit(EnumValue const& _node)
 bool ASTJsonConverter::visit(ParameterList const& _node)
 {
 	setJsonNode(_node, "ParameterList", {
-		make_pair("parameters", toJson(_node.parameters()))
+		make_pair("parameters", children(_node.parameters()))
 	});
 	return false;
 }
 
 bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
 		make_pair("kind", _node.isConstructor() ? "constructor" : (_node.isFallback() ? "fallback" : "function")),
 		make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
 		make_pair("superFunction", idOrNull(_node.annotation().superFunction)),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("parameters", toJson(_node.parameterList())),
-		make_pair("returnParameters", toJson(*_node.returnParameterList())),
-		make_pair("modifiers", toJson(_node.modifiers())),
-		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue),
+		make_pair("parameters", child(_node.parameterList())),
+		make_pair("returnParameters", child(*_node.returnParameterList())),
+		make_pair("modifiers", children(_node.modifiers())),
+		make_pair("body", _node.isImplemented() ? child(_node.body()) : Json::nullValue),
 		make_pair("implemented", _node.isImplemented()),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
@@ -350,14 +555,14 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.name()),
-		make_pair("typeName", toJsonOrNull(_node.typeName())),
+		make_pair("typeName", childOrNull(_node.typeName())),
 		make_pair("constant", _node.isConstant()),
 		make_pair("stateVariable", _node.isStateVariable()),
 		make_pair("storageLocation", location(_node.referenceLocation())),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("value", _node.value() ? toJson(*_node.value()) : Json::nullValue),
+		make_pair("value", _node.value() ? child(*_node.value()) : Json::nullValue),
 		make_pair("scope", idOrNull(_node.scope())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -373,8 +578,8 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		make_pair("parameters", toJson(_node.parameterList())),
-		make_pair("body", toJson(_node.body()))
+		make_pair("parameters", child(_node.parameterList())),
+		make_pair("body", child(_node.body()))
 	});
 	return false;
 }
@@ -382,8 +587,8 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 bool ASTJsonConverter::visit(ModifierInvocation const& _node)
 {
 	setJsonNode(_node, "ModifierInvocation", {
-		make_pair("modifierName", toJson(*_node.name())),
-		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+		make_pair("modifierName", child(*_node.name())),
+		make_pair("arguments", _node.arguments() ? children(*_node.arguments()) : Json::nullValue)
 	});
 	return false;
 }
@@ -394,7 +599,7 @@ bool ASTJsonConverter::visit(EventDefinition const& _node)
 	setJsonNode(_node, "EventDefinition", {
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
-		make_pair("parameters", toJson(_node.parameterList())),
+		make_pair("parameters", child(_node.parameterList())),
 		make_pair("anonymous", _node.isAnonymous())
 	});
 	return false;
@@ -402,7 +607,7 @@ bool ASTJsonConverter::visit(EventDefinition const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("name", _node.typeName().toString()),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -430,8 +635,8 @@ bool ASTJsonConverter::visit(FunctionTypeName const& _node)
 	setJsonNode(_node, "FunctionTypeName", {
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
-		make_pair("parameterTypes", toJson(*_node.parameterTypeList())),
-		make_pair("returnParameterTypes", toJson(*_node.returnParameterTypeList())),
+		make_pair("parameterTypes", child(*_node.parameterTypeList())),
+		make_pair("returnParameterTypes", child(*_node.returnParameterTypeList())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -440,8 +645,8 @@ bool ASTJsonConverter::visit(FunctionTypeName const& _node)
 bool ASTJsonConverter::visit(Mapping const& _node)
 {
 	setJsonNode(_node, "Mapping", {
-		make_pair("keyType", toJson(_node.keyType())),
-		make_pair("valueType", toJson(_node.valueType())),
+		make_pair("keyType", child(_node.keyType())),
+		make_pair("valueType", child(_node.valueType())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -450,8 +655,8 @@ bool ASTJsonConverter::visit(Mapping const& _node)
 bool ASTJsonConverter::visit(ArrayTypeName const& _node)
 {
 	setJsonNode(_node, "ArrayTypeName", {
-		make_pair("baseType", toJson(_node.baseType())),
-		make_pair("length", toJsonOrNull(_node.length())),
+		make_pair("baseType", child(_node.baseType())),
+		make_pair("length", childOrNull(_node.length())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -477,7 +682,7 @@ bool ASTJsonConverter::visit(InlineAssembly const& _node)
 bool ASTJsonConverter::visit(Block const& _node)
 {
 	setJsonNode(_node, "Block", {
-		make_pair("statements", toJson(_node.statements()))
+		make_pair("statements", children(_node.statements()))
 	});
 	return false;
 }
@@ -491,9 +696,9 @@ bool ASTJsonConverter::visit(PlaceholderStatement const& _node)
 bool ASTJsonConverter::visit(IfStatement const& _node)
 {
 	setJsonNode(_node, "IfStatement", {
-		make_pair("condition", toJson(_node.condition())),
-		make_pair("trueBody", toJson(_node.trueStatement())),
-		make_pair("falseBody", toJsonOrNull(_node.falseStatement()))
+		make_pair("condition", child(_node.condition())),
+		make_pair("trueBody", child(_node.trueStatement())),
+		make_pair("falseBody", childOrNull(_node.falseStatement()))
 	});
 	return false;
 }
@@ -504,8 +709,8 @@ bool ASTJsonConverter::visit(WhileStatement const& _node)
 		_node,
 		_node.isDoWhile() ? "DoWhileStatement" : "WhileStatement",
 		{
-			make_pair("condition", toJson(_node.condition())),
-			make_pair("body", toJson(_node.body()))
+			make_pair("condition", child(_node.condition())),
+			make_pair("body", child(_node.body()))
 		}
 	);
 	return false;
@@ -514,10 +719,10 @@ bool ASTJsonConverter::visit(WhileStatement const& _node)
 bool ASTJsonConverter::visit(ForStatement const& _node)
 {
 	setJsonNode(_node, "ForStatement", {
-		make_pair("initializationExpression", toJsonOrNull(_node.initializationExpression())),
-		make_pair("condition", toJsonOrNull(_node.condition())),
-		make_pair("loopExpression", toJsonOrNull(_node.loopExpression())),
-		make_pair("body", toJson(_node.body()))
+		make_pair("initializationExpression", childOrNull(_node.initializationExpression())),
+		make_pair("condition", childOrNull(_node.condition())),
+		make_pair("loopExpression", childOrNull(_node.loopExpression())),
+		make_pair("body", child(_node.body()))
 	});
 	return false;
 }
@@ -537,7 +742,7 @@ bool ASTJsonConverter::visit(Break const& _node)
 bool ASTJsonConverter::visit(Return const& _node)
 {
 	setJsonNode(_node, "Return", {
-		make_pair("expression", toJsonOrNull(_node.expression())),
+		make_pair("expression", childOrNull(_node.expression())),
 		make_pair("functionReturnParameters", idOrNull(_node.annotation().functionReturnParameters))
 	});
 	return false;
@@ -552,7 +757,7 @@ bool ASTJsonConverter::visit(Throw const& _node)
 bool ASTJsonConverter::visit(EmitStatement const& _node)
 {
 	setJsonNode(_node, "EmitStatement", {
-		make_pair("eventCall", toJson(_node.eventCall()))
+		make_pair("eventCall", child(_node.eventCall()))
 	});
 	return false;
 }
@@ -564,8 +769,8 @@ bool ASTJsonConverter::visit(VariableDeclarationStatement const& _node)
 		appendMove(varDecs, idOrNull(v.get()));
 	setJsonNode(_node, "VariableDeclarationStatement", {
 		make_pair("assignments", std::move(varDecs)),
-		make_pair("declarations", toJson(_node.declarations())),
-		make_pair("initialValue", toJsonOrNull(_node.initialValue()))
+		make_pair("declarations", children(_node.declarations())),
+		make_pair("initialValue", childOrNull(_node.initialValue()))
 	});
 	return false;
 }
@@ -573,17 +778,17 @@ bool ASTJsonConverter::visit(VariableDeclarationStatement const& _node)
 bool ASTJsonConverter::visit(ExpressionStatement const& _node)
 {
 	setJsonNode(_node, "ExpressionStatement", {
-		make_pair("expression", toJson(_node.expression()))
+		make_pair("expression", child(_node.expression()))
 	});
 	return false;
 }
 
 bool ASTJsonConverter::visit(Conditional const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("condition", toJson(_node.condition())),
-		make_pair("trueExpression", toJson(_node.trueExpression())),
-		make_pair("falseExpression", toJson(_node.falseExpression()))
+	Attributes attributes = {
+		make_pair("condition", child(_node.condition())),
+		make_pair("trueExpression", child(_node.trueExpression())),
+		make_pair("falseExpression", child(_node.falseExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
@@ -592,10 +797,10 @@ bool ASTJsonConverter::visit(Conditional const& _node)
 
 bool ASTJsonConverter::visit(Assignment const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
-		make_pair("leftHandSide", toJson(_node.leftHandSide())),
-		make_pair("rightHandSide", toJson(_node.rightHandSide()))
+		make_pair("leftHandSide", child(_node.leftHandSide())),
+		make_pair("rightHandSide", child(_node.rightHandSide()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode( _node, "Assignment", std::move(attributes));
@@ -604,9 +809,9 @@ bool ASTJsonConverter::visit(Assignment const& _node)
 
 bool ASTJsonConverter::visit(TupleExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("isInlineArray", Json::Value(_node.isInlineArray())),
-		make_pair("components", toJson(_node.components())),
+		make_pair("components", children(_node.components())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
@@ -615,10 +820,10 @@ bool ASTJsonConverter::visit(TupleExpression const& _node)
 
 bool ASTJsonConverter::visit(UnaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("prefix", _node.isPrefixOperation()),
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		make_pair("subExpression", toJson(_node.subExpression()))
+		make_pair("subExpression", child(_node.subExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "UnaryOperation", std::move(attributes));
@@ -627,10 +832,10 @@ bool ASTJsonConverter::visit(UnaryOperation const& _node)
 
 bool ASTJsonConverter::visit(BinaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		make_pair("leftExpression", toJson(_node.leftExpression())),
-		make_pair("rightExpression", toJson(_node.rightExpression())),
+		make_pair("leftExpression", child(_node.leftExpression())),
+		make_pair("rightExpression", child(_node.rightExpression())),
 		make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -643,10 +848,10 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 	Json::Value names(Json::arrayValue);
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("expression", toJson(_node.expression())),
+	Attributes attributes = {
+		make_pair("expression", child(_node.expression())),
 		make_pair("names", std::move(names)),
-		make_pair("arguments", toJson(_node.arguments()))
+		make_pair("arguments", children(_node.arguments()))
 	};
 	if (m_legacy)
 	{
@@ -662,8 +867,8 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 
 bool ASTJsonConverter::visit(NewExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("typeName", toJson(_node.typeName()))
+	Attributes attributes = {
+		make_pair("typeName", child(_node.typeName()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
@@ -672,9 +877,9 @@ bool ASTJsonConverter::visit(NewExpression const& _node)
 
 bool ASTJsonConverter::visit(MemberAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "member_name" : "memberName", _node.memberName()),
-		make_pair("expression", toJson(_node.expression())),
+		make_pair("expression", child(_node.expression())),
 		make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -684,9 +889,9 @@ bool ASTJsonConverter::visit(MemberAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
-		make_pair("baseExpression", toJson(_node.baseExpression())),
-		make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
+	Attributes attributes = {
+		make_pair("baseExpression", child(_node.baseExpression())),
+		make_pair("indexExpression", childOrNull(_node.indexExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
@@ -710,7 +915,7 @@ bool ASTJsonConverter::visit(Identifier const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "value" : "typeName", _node.typeName().toString())
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -724,7 +929,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 	if (!dev::validateUTF8(_node.value()))
 		value = Json::nullValue;
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<pair<string, Json::Value>> attributes = {
+	Attributes attributes = {
 		make_pair(m_legacy ? "token" : "kind", literalTokenKind(_node.token())),
 		make_pair("value", value),
 		make_pair(m_legacy ? "hexvalue" : "hexValue", toHex(asBytes(_node.value()))),
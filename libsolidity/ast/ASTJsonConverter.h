@@ -32,6 +32,7 @@
 #include <optional>
 #include <ostream>
 #include <stack>
+#include <type_traits>
 #include <vector>
 
 namespace langutil
@@ -59,6 +60,10 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Output the compact json representation of the AST to _stream. The nodes are written
+	/// while the AST is traversed, without building the json tree first.
+	/// The output is identical to jsonCompactPrint(toJson(_node)).
+	void printCompact(std::ostream& _stream, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -120,26 +125,73 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Value of a node attribute: Either a json value or child nodes. Child nodes are
+	/// only converted once the node they belong to is output.
+	struct AttributeValue
+	{
+		template <class T, typename = std::enable_if_t<std::is_constructible<Json::Value, T>::value>>
+		AttributeValue(T&& _value): json(std::forward<T>(_value)) {}
+		AttributeValue(std::vector<ASTNode const*> _nodes, bool _isList):
+			nodes(std::move(_nodes)), isNodeList(_isList)
+		{}
+
+		Json::Value json;
+		/// Child nodes. Null pointers are only allowed in lists.
+		std::vector<ASTNode const*> nodes;
+		/// If true, the value is the list of @a nodes. Otherwise it is the single
+		/// node in @a nodes or @a json if there is no such node.
+		bool isNodeList = false;
+	};
+	using Attributes = std::vector<std::pair<std::string, AttributeValue>>;
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+		std::initializer_list<std::pair<std::string, AttributeValue>>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::vector<std::pair<std::string, Json::Value>>&& _attributes
+		Attributes&& _attributes
+	);
+	/// Writes the node directly to the output stream, used by printCompact.
+	void writeJsonNode(
+		ASTNode const& _node,
+		std::string const& _nodeName,
+		Attributes&& _attributes
 	);
+	/// Writes the node in legacy format directly to the output stream, used by printCompact.
+	void writeLegacyJsonNode(
+		ASTNode const& _node,
+		std::string const& _nodeName,
+		Attributes&& _attributes
+	);
+	/// Converts the attribute value to json, converting any child nodes.
+	Json::Value toJson(AttributeValue&& _value);
+	/// Writes the attribute value to the output stream, writing any child nodes directly.
+	void write(AttributeValue const& _value);
+	static AttributeValue child(ASTNode const& _node)
+	{
+		return AttributeValue({&_node}, false);
+	}
+	static AttributeValue childOrNull(ASTNode const* _node)
+	{
+		return _node ? child(*_node) : Json::nullValue;
+	}
+	template <class T>
+	static AttributeValue children(std::vector<ASTPointer<T>> const& _nodes)
+	{
+		std::vector<ASTNode const*> nodes;
+		for (auto const& n: _nodes)
+			nodes.push_back(n.get());
+		return AttributeValue(std::move(nodes), true);
+	}
 	std::string sourceLocationToString(langutil::SourceLocation const& _location) const;
 	static std::string namePathToString(std::vector<ASTString> const& _namePath);
 	static Json::Value idOrNull(ASTNode const* _pt)
 	{
 		return _pt ? Json::Value(nodeId(*_pt)) : Json::nullValue;
 	}
-	Json::Value toJsonOrNull(ASTNode const* _node)
-	{
-		return _node ? toJson(*_node) : Json::nullValue;
-	}
 	Json::Value inlineAssemblyIdentifierToJson(std::pair<yul::Identifier const* , InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const;
 	static std::string location(VariableDeclaration::Location _location);
 	static std::string contractKind(ContractDefinition::ContractKind _kind);
@@ -173,7 +225,7 @@ private:
 	static Json::Value typePointerToJson(TypePointer _tp, bool _short = false);
 	static Json::Value typePointerToJson(std::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
-		std::vector<std::pair<std::string, Json::Value>> &_attributes,
+		Attributes& _attributes,
 		ExpressionAnnotation const& _annotation
 	);
 	static void appendMove(Json::Value& _array, Json::Value&& _value)
@@ -185,6 +237,8 @@ private:
 	bool m_legacy = false; ///< if true, use legacy format
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Stream the nodes are written to directly, only set during printCompact.
+	std::ostream* m_stream = nullptr;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
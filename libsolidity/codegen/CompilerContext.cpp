@@ -41,6 +41,8 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libdevcore/Keccak256.h>
+
 #include <boost/algorithm/string/replace.hpp>
 
 #include <utility>
@@ -59,6 +61,50 @@ using namespace dev::eth;
 using namespace dev;
 using namespace dev::solidity;
 
+namespace
+{
+
+/// Optimised Yul code together with its analysis information.
+struct OptimisedInlineAssembly
+{
+	shared_ptr<yul::Block> code;
+	shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+};
+
+/// Cache of optimised inline assembly snippets, shared by all contracts compiled in this
+/// process. The ABI and utility functions generated by the code generator are mostly
+/// identical between contracts, so they only have to be optimised once.
+/// The cache is cleared together with the Yul string repository.
+map<h256, OptimisedInlineAssembly>& optimisedInlineAssemblyCache()
+{
+	static map<h256, OptimisedInlineAssembly> cache;
+	static yul::YulStringRepository::ResetCallback callback{[&] { cache.clear(); }};
+	return cache;
+}
+
+/// @returns the key under which the optimised version of @a _assembly is cached.
+/// Takes into account everything the result of the Yul optimiser depends on.
+h256 optimisedInlineAssemblyKey(
+	string const& _assembly,
+	set<yul::YulString> const& _externallyUsedIdentifiers,
+	EVMVersion _evmVersion,
+	bool _isCreation,
+	OptimiserSettings const& _optimiserSettings
+)
+{
+	string key = _assembly;
+	key += "\n" + _evmVersion.name();
+	key += _isCreation ? "\ncreation" : "\nruntime";
+	key += "\n" + to_string(_optimiserSettings.expectedExecutionsPerDeployment);
+	key += _optimiserSettings.optimizeStackAllocation ? "\nstackAllocation" : "";
+	key += "\n" + _optimiserSettings.yulOptimiserSteps;
+	for (auto const& identifier: _externallyUsedIdentifiers)
+		key += "\n" + identifier.str();
+	return keccak256(key);
+}
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -381,6 +427,45 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	auto assemble = [&](yul::Block const& _code, yul::AsmAnalysisInfo& _analysisInfo)
+	{
+		yul::CodeGenerator::assemble(
+			_code,
+			_analysisInfo,
+			*m_asm,
+			m_evmVersion,
+			identifierAccess,
+			_system,
+			_optimiserSettings.optimizeStackAllocation,
+			_optimiserSettings.optimizeStackLayout
+		);
+
+		// Reset the source location to the one of the node (instead of the CODEGEN source location)
+		updateSourceLocation();
+	};
+
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	bool const isCreation = m_runtimeContext != nullptr;
+	h256 cacheKey;
+	if (optimize)
+	{
+		cacheKey = optimisedInlineAssemblyKey(
+			_assembly,
+			externallyUsedIdentifiers,
+			m_evmVersion,
+			isCreation,
+			_optimiserSettings
+		);
+		auto cached = optimisedInlineAssemblyCache().find(cacheKey);
+		if (cached != optimisedInlineAssemblyCache().end())
+		{
+			assemble(*cached->second.code, *cached->second.analysisInfo);
+			return;
+		}
+	}
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
@@ -405,11 +490,11 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
+	auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
 	bool analyzerResult = false;
 	if (parserResult)
 		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
+			*analysisInfo,
 			errorReporter,
 			std::nullopt,
 			dialect,
@@ -418,24 +503,23 @@ void CompilerContext::appendInlineAssembly(
 	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
 		reportError("Invalid assembly generated by code generator.");
 
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	if (optimize)
 	{
-		bool const isCreation = m_runtimeContext != nullptr;
 		yul::GasMeter meter(dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
 		yul::Object obj;
 		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		obj.analysisInfo = analysisInfo;
 		yul::OptimiserSuite::run(
 			dialect,
 			&meter,
 			obj,
 			_optimiserSettings.optimizeStackAllocation,
+			_optimiserSettings.yulOptimiserSteps,
 			externallyUsedIdentifiers
 		);
-		analysisInfo = std::move(*obj.analysisInfo);
+		analysisInfo = std::move(obj.analysisInfo);
 		parserResult = std::move(obj.code);
+		optimisedInlineAssemblyCache()[cacheKey] = {parserResult, analysisInfo};
 
 #ifdef SOL_OUTPUT_ASM
 		cout << "After optimizer:" << endl;
@@ -447,18 +531,7 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
-		*m_asm,
-		m_evmVersion,
-		identifierAccess,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
-
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	assemble(*parserResult, *analysisInfo);
 }
 
 FunctionDefinition const& CompilerContext::resolveVirtualFunction(
@@ -765,7 +765,8 @@ bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
 		m_context.evmVersion(),
 		identifierAccess,
 		false,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		m_optimiserSettings.optimizeStackLayout
 	);
 	m_context.setStackOffset(startStackHeight);
 	return false;
@@ -32,7 +32,11 @@ using namespace dev::solidity;
 
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
+	size_t size = 0;
+	for (auto const& f: m_requestedFunctions)
+		size += f.second.size();
 	string result;
+	result.reserve(size);
 	for (auto const& f: m_requestedFunctions)
 		result += f.second;
 	m_requestedFunctions.clear();
@@ -41,12 +45,14 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
+	auto it = m_requestedFunctions.lower_bound(_name);
+	if (it == m_requestedFunctions.end() || it->first != _name)
 	{
 		string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
-		m_requestedFunctions[_name] = std::move(fun);
+		// The creator can add other functions, so the position is only used as a hint.
+		m_requestedFunctions.emplace_hint(it, _name, std::move(fun));
 	}
 	return _name;
 }
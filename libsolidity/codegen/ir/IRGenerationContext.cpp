@@ -74,15 +74,18 @@ FunctionDefinition const& IRGenerationContext::virtualFunction(FunctionDefinitio
 {
 	// @TODO previously, we had to distinguish creation context and runtime context,
 	// but since we do not work with jump positions anymore, this should not be a problem, right?
-	string name = _function.name();
+	string const& name = _function.name();
+	if (m_functionsByName.empty())
+		for (auto const& contract: m_inheritanceHierarchy)
+			for (FunctionDefinition const* function: contract->definedFunctions())
+				if (!function->isConstructor())
+					m_functionsByName[function->name()].push_back(function);
+
 	FunctionType functionType(_function);
-	for (auto const& contract: m_inheritanceHierarchy)
-		for (FunctionDefinition const* function: contract->definedFunctions())
-			if (
-				function->name() == name &&
-				!function->isConstructor() &&
-				FunctionType(*function).asCallableFunction(false)->hasEqualParameterTypes(functionType)
-			)
+	auto candidates = m_functionsByName.find(name);
+	if (candidates != m_functionsByName.end())
+		for (FunctionDefinition const* function: candidates->second)
+			if (FunctionType(*function).asCallableFunction(false)->hasEqualParameterTypes(functionType))
 				return *function;
 	solAssert(false, "Super function " + name + " not found.");
 }
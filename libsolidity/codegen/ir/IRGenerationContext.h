@@ -30,6 +30,7 @@
 
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace dev
@@ -61,6 +62,7 @@ public:
 	void setInheritanceHierarchy(std::vector<ContractDefinition const*> _hierarchy)
 	{
 		m_inheritanceHierarchy = std::move(_hierarchy);
+		m_functionsByName.clear();
 	}
 
 
@@ -99,6 +101,9 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	OptimiserSettings m_optimiserSettings;
 	std::vector<ContractDefinition const*> m_inheritanceHierarchy;
+	/// Non-constructor functions of the inheritance hierarchy by name, from derived to base.
+	/// Built on first use by virtualFunction.
+	std::unordered_map<std::string, std::vector<FunctionDefinition const*>> m_functionsByName;
 	std::map<VariableDeclaration const*, std::string> m_localVariables;
 	/// Storage offsets of state variables
 	std::map<VariableDeclaration const*, std::pair<u256, unsigned>> m_stateVariables;
@@ -47,29 +47,39 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
-pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
+namespace
+{
+
+string const warning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+pair<string, shared_ptr<yul::AssemblyStack>> IRGenerator::run(ContractDefinition const& _contract)
 {
 	string const ir = yul::reindent(generate(_contract));
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+	auto asmStack = make_shared<yul::AssemblyStack>(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	if (!asmStack->parseAndAnalyze("", ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+	asmStack->optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {warning + ir, move(asmStack)};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::printOptimized(yul::AssemblyStack const& _stack)
+{
+	return warning + _stack.print();
 }
 
 string IRGenerator::generate(ContractDefinition const& _contract)
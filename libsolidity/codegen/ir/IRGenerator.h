@@ -27,8 +27,14 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <memory>
 #include <string>
 
+namespace yul
+{
+class AssemblyStack;
+}
+
 namespace dev
 {
 namespace solidity
@@ -46,9 +52,12 @@ public:
 		m_utils(_evmVersion, m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(ContractDefinition const& _contract);
+	/// Generates and returns the IR code in unoptimized form, together with the assembly stack
+	/// that holds the parsed and analyzed code, optimized depending on the optimizer settings.
+	std::pair<std::string, std::shared_ptr<yul::AssemblyStack>> run(ContractDefinition const& _contract);
+
+	/// @returns the pretty-printed code of an assembly stack returned by run.
+	static std::string printOptimized(yul::AssemblyStack const& _stack);
 
 private:
 	std::string generate(ContractDefinition const& _contract);
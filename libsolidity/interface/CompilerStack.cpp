@@ -70,6 +70,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <charconv>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
@@ -81,6 +83,7 @@ CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_readFile{_readFile},
 	m_generateIR{false},
 	m_generateEWasm{false},
+	m_outputOptimizedIR{false},
 	m_errorList{},
 	m_errorReporter{m_errorList}
 {
@@ -153,6 +156,14 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 	m_optimiserSettings = std::move(_settings);
 }
 
+void CompilerStack::enableBoundedMemory(function<void(string const&)> _contractCompiled, set<string> _keptASTs)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must enable the bounded-memory mode before compiling."));
+	m_contractCompiled = move(_contractCompiled);
+	m_keptASTs = move(_keptASTs);
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsingPerformed)
@@ -181,6 +192,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_generateIR = false;
 		m_generateEWasm = false;
+		m_outputOptimizedIR = false;
+		m_contractCompiled = nullptr;
+		m_keptASTs.clear();
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
@@ -435,18 +449,88 @@ bool CompilerStack::compile()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR || m_generateEWasm)
-						generateIR(*contract);
-					if (m_generateEWasm)
-						generateEWasm(*contract);
-				}
+					requestedContracts.push_back(contract);
+
+	// In the bounded-memory mode, the index of the last requested contract that needs the
+	// compiler of a contract or the AST of a source.
+	map<ContractDefinition const*, size_t> lastCompilerUse;
+	map<SourceUnit const*, size_t> lastASTUse;
+	if (m_contractCompiled)
+	{
+		map<SourceUnit const*, size_t> lastContractInSource;
+		for (size_t i = 0; i < requestedContracts.size(); ++i)
+		{
+			// Contracts created by a contract are compiled along with it if they are not compiled yet.
+			function<void(ContractDefinition const&)> markUsed = [&](ContractDefinition const& _contract)
+			{
+				auto it = lastCompilerUse.find(&_contract);
+				if (it != lastCompilerUse.end() && it->second == i)
+					return;
+				lastCompilerUse[&_contract] = i;
+				for (auto const* dependency: _contract.annotation().contractDependencies)
+					markUsed(*dependency);
+			};
+			markUsed(*requestedContracts[i]);
+			lastContractInSource[&requestedContracts[i]->sourceUnit()] = i;
+		}
+		for (auto const& [sourceUnit, last]: lastContractInSource)
+			for (SourceUnit const* referencedSource: sourceUnit->referencedSourceUnits(true) + set<SourceUnit const*>{sourceUnit})
+				lastASTUse[referencedSource] = max(lastASTUse[referencedSource], last);
+	}
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	for (size_t i = 0; i < requestedContracts.size(); ++i)
+	{
+		ContractDefinition const& contract = *requestedContracts[i];
+		compileContract(contract, otherCompilers);
+		if (m_generateIR || m_generateEWasm)
+			generateIR(contract);
+		if (m_generateEWasm)
+			generateEWasm(contract);
+
+		if (!m_contractCompiled)
+			continue;
+
+		Contract& compiledContract = m_contracts.at(contract.fullyQualifiedName());
+		compiledContract.object.link(m_libraries);
+		compiledContract.runtimeObject.link(m_libraries);
+		{
+			// All outputs of the contract are available at this point.
+			m_stackState = CompilationSuccessful;
+			ScopeGuard resetState([&]() { m_stackState = AnalysisPerformed; });
+			m_contractCompiled(contract.fullyQualifiedName());
+		}
+		releaseContract(compiledContract);
+
+		for (auto it = otherCompilers.begin(); it != otherCompilers.end();)
+			if (lastCompilerUse.count(it->first) && lastCompilerUse.at(it->first) > i)
+				++it;
+			else
+			{
+				// Also releases contracts that were only compiled because other contracts create them.
+				releaseContract(m_contracts.at(it->first->fullyQualifiedName()));
+				it = otherCompilers.erase(it);
+			}
+
+		for (auto& [sourceName, source]: m_sources)
+		{
+			if (!source.ast || m_keptASTs.count(sourceName))
+				continue;
+			auto it = lastASTUse.find(source.ast.get());
+			if (it != lastASTUse.end() && it->second > i)
+				continue;
+			for (auto& contractEntry: m_contracts)
+				if (contractEntry.second.contract && contractEntry.second.contract->sourceUnitName() == sourceName)
+					releaseContract(contractEntry.second);
+			source.ast.reset();
+			source.astReleased = true;
+		}
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -531,6 +615,34 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	return c.runtimeSourceMapping.get();
 }
 
+bytes const* CompilerStack::binarySourceMapping(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	if (!c.binarySourceMapping)
+	{
+		if (auto items = assemblyItems(_contractName))
+			c.binarySourceMapping = make_unique<bytes>(computeBinarySourceMapping(*items));
+	}
+	return c.binarySourceMapping.get();
+}
+
+bytes const* CompilerStack::runtimeBinarySourceMapping(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	if (!c.runtimeBinarySourceMapping)
+	{
+		if (auto items = runtimeAssemblyItems(_contractName))
+			c.runtimeBinarySourceMapping = make_unique<bytes>(computeBinarySourceMapping(*items));
+	}
+	return c.runtimeBinarySourceMapping.get();
+}
+
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -568,7 +680,15 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	return contract(_contractName).yulIROptimized;
+	Contract const& c = contract(_contractName);
+	if (!c.yulIROptimized)
+	{
+		// The eWasm generation consumes the optimized IR unless it was told to keep it.
+		if (!c.yulIRStack && !c.eWasm.empty())
+			BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Optimized IR was not kept during eWasm generation."));
+		c.yulIROptimized = make_unique<string>(c.yulIRStack ? IRGenerator::printOptimized(*c.yulIRStack) : "");
+	}
+	return *c.yulIROptimized;
 }
 
 string const& CompilerStack::eWasm(string const& _contractName) const
@@ -779,6 +899,8 @@ SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 {
 	if (m_stackState < ParsingPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing not yet performed."));
+	if (source(_sourceName).astReleased)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("The AST of \"" + _sourceName + "\" has already been released."));
 	if (!source(_sourceName).ast && !m_parserErrorRecovery)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Parsing was not successful."));
 
@@ -1028,6 +1150,12 @@ void CompilerStack::compileContract(
 	_otherCompilers[compiledContract.contract] = compiler;
 }
 
+void CompilerStack::releaseContract(Contract& _contract)
+{
+	_contract = Contract{};
+	_contract.released = true;
+}
+
 void CompilerStack::generateIR(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1045,7 +1173,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		generateIR(*dependency);
 
 	IRGenerator generator(m_evmVersion, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
+	tie(compiledContract.yulIR, compiledContract.yulIRStack) = generator.run(_contract);
 }
 
 void CompilerStack::generateEWasm(ContractDefinition const& _contract)
@@ -1055,14 +1183,22 @@ void CompilerStack::generateEWasm(ContractDefinition const& _contract)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateEWasm with errors."));
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.eWasm.empty())
 		return;
+	solAssert(compiledContract.yulIRStack, "");
+
+	// The translation modifies the code, so the optimized IR has to be printed before
+	// if it is requested.
+	if (m_outputOptimizedIR && !compiledContract.yulIROptimized)
+		compiledContract.yulIROptimized = make_unique<string>(IRGenerator::printOptimized(*compiledContract.yulIRStack));
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	// Continue with the Yul IR in EVM dialect without printing and re-parsing it.
+	shared_ptr<yul::AssemblyStack> stackPtr = move(compiledContract.yulIRStack);
+	yul::AssemblyStack& stack = *stackPtr;
 
+	// The optimized IR used to be re-parsed at this point, which turned instructions
+	// in functional notation into builtin calls, as the translation expects.
+	stack.convertToBuiltinCalls();
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::EWasm);
 	stack.optimize();
@@ -1079,9 +1215,16 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 
+	auto unreleased = [&](Contract const& _contract) -> Contract const&
+	{
+		if (_contract.released)
+			BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Contract \"" + _contractName + "\" has already been released."));
+		return _contract;
+	};
+
 	auto it = m_contracts.find(_contractName);
 	if (it != m_contracts.end())
-		return it->second;
+		return unreleased(it->second);
 
 	// To provide a measure of backward-compatibility, if a contract is not located by its
 	// fully-qualified name, a lookup will be attempted purely on the contract's name to see
@@ -1098,7 +1241,7 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 			getline(ss, source, ':');
 			getline(ss, foundName, ':');
 			if (foundName == _contractName)
-				return contractEntry.second;
+				return unreleased(contractEntry.second);
 		}
 	}
 
@@ -1173,6 +1316,10 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.optimizeStackLayout)
+				details["yulDetails"]["stackLayout"] = true;
+			if (m_optimiserSettings.yulOptimiserSteps != OptimiserSettings::DefaultYulOptimiserSteps)
+				details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1298,45 +1445,98 @@ bytes CompilerStack::createCBORMetadata(string const& _metadata, bool _experimen
 	return encoder.serialise();
 }
 
+namespace
+{
+
+/// Source location of a single assembly item, as used in the source mappings.
+struct SourceMappingEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jump = '-';
+};
+
+/// Calls @a _visitor with the source mapping entry of every item in @a _items.
+template <class Visitor>
+void visitSourceMappingEntries(
+	eth::AssemblyItems const& _items,
+	map<string, unsigned> const& _sourceIndices,
+	Visitor&& _visitor
+)
+{
+	// Consecutive items mostly belong to the same source, so the index of the last
+	// source is kept to avoid looking up its name for every item.
+	CharStream const* lastSource = nullptr;
+	int lastSourceIndex = -1;
+	for (auto const& item: _items)
+	{
+		SourceLocation const& location = item.location();
+		SourceMappingEntry entry;
+		entry.start = location.start;
+		entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		if (location.source)
+		{
+			if (location.source.get() != lastSource)
+			{
+				auto it = _sourceIndices.find(location.source->name());
+				lastSource = location.source.get();
+				lastSourceIndex = it != _sourceIndices.end() ? int(it->second) : -1;
+			}
+			entry.sourceIndex = lastSourceIndex;
+		}
+		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
+			entry.jump = 'i';
+		else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction)
+			entry.jump = 'o';
+		_visitor(entry);
+	}
+}
+
+void appendInteger(string& _output, int _value)
+{
+	char buffer[16];
+	auto result = to_chars(begin(buffer), end(buffer), _value);
+	_output.append(buffer, result.ptr);
+}
+
+/// Appends @a _value in zigzag encoding as unsigned LEB128.
+void appendVarint(bytes& _output, int _value)
+{
+	uint32_t value = (uint32_t(_value) << 1) ^ uint32_t(_value >> 31);
+	for (; value >= 0x80; value >>= 7)
+		_output.push_back(uint8_t(value | 0x80));
+	_output.push_back(uint8_t(value));
+}
+
+}
+
 string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	string ret;
-	map<string, unsigned> sourceIndicesMap = sourceIndices();
-	int prevStart = -1;
-	int prevLength = -1;
-	int prevSourceIndex = -1;
-	char prevJump = 0;
-	for (auto const& item: _items)
+	// Most entries are empty or only contain a short offset.
+	ret.reserve(_items.size() * 4);
+	SourceMappingEntry prev;
+	prev.jump = 0;
+	visitSourceMappingEntries(_items, sourceIndices(), [&](SourceMappingEntry const& _entry)
 	{
 		if (!ret.empty())
-			ret += ";";
-
-		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && sourceIndicesMap.count(location.source->name()) ?
-			sourceIndicesMap.at(location.source->name()) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
+			ret += ';';
 
 		unsigned components = 4;
-		if (jump == prevJump)
+		if (_entry.jump == prev.jump)
 		{
 			components--;
-			if (sourceIndex == prevSourceIndex)
+			if (_entry.sourceIndex == prev.sourceIndex)
 			{
 				components--;
-				if (length == prevLength)
+				if (_entry.length == prev.length)
 				{
 					components--;
-					if (location.start == prevStart)
+					if (_entry.start == prev.start)
 						components--;
 				}
 			}
@@ -1344,33 +1544,59 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 
 		if (components-- > 0)
 		{
-			if (location.start != prevStart)
-				ret += to_string(location.start);
+			if (_entry.start != prev.start)
+				appendInteger(ret, _entry.start);
 			if (components-- > 0)
 			{
 				ret += ':';
-				if (length != prevLength)
-					ret += to_string(length);
+				if (_entry.length != prev.length)
+					appendInteger(ret, _entry.length);
 				if (components-- > 0)
 				{
 					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+					if (_entry.sourceIndex != prev.sourceIndex)
+						appendInteger(ret, _entry.sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
+						if (_entry.jump != prev.jump)
+							ret += _entry.jump;
 					}
 				}
 			}
 		}
 
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-	}
+		prev = _entry;
+	});
+	return ret;
+}
+
+bytes CompilerStack::computeBinarySourceMapping(eth::AssemblyItems const& _items) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	bytes ret;
+	ret.reserve(_items.size() * 2);
+	SourceMappingEntry prev;
+	visitSourceMappingEntries(_items, sourceIndices(), [&](SourceMappingEntry const& _entry)
+	{
+		uint8_t changed =
+			(_entry.start != prev.start ? 1 : 0) |
+			(_entry.length != prev.length ? 2 : 0) |
+			(_entry.sourceIndex != prev.sourceIndex ? 4 : 0) |
+			(_entry.jump != prev.jump ? 8 : 0);
+		ret.push_back(changed);
+		if (changed & 1)
+			appendVarint(ret, _entry.start - prev.start);
+		if (changed & 2)
+			appendVarint(ret, _entry.length);
+		if (changed & 4)
+			appendVarint(ret, _entry.sourceIndex);
+		if (changed & 8)
+			ret.push_back(uint8_t(_entry.jump));
+		prev = _entry;
+	});
 	return ret;
 }
 
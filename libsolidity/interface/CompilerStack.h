@@ -44,6 +44,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace langutil
@@ -51,6 +52,11 @@ namespace langutil
 class Scanner;
 }
 
+namespace yul
+{
+class AssemblyStack;
+}
+
 namespace dev
 {
 
@@ -167,6 +173,21 @@ public:
 	/// Enable experimental generation of eWasm code. If enabled, IR is also generated.
 	void enableEWasmGeneration(bool _enable = true) { m_generateEWasm = _enable; }
 
+	/// Keep the optimized Yul IR as text even if eWasm is generated from it. Without this,
+	/// the optimized IR is not available after eWasm generation.
+	void enableOptimizedIROutput(bool _enable = true) { m_outputOptimizedIR = _enable; }
+
+	/// Enables the bounded-memory mode, in which compile() calls @a _contractCompiled with the name
+	/// of each requested contract as soon as that contract has been compiled. Once the callback
+	/// returns, the compiler, the intermediate representations and the outputs of the contract are
+	/// released, so they can only be retrieved from inside the callback. The ASTs of sources not
+	/// listed in @a _keptASTs are released as soon as no contract still to be compiled refers to them.
+	/// Must be set before compiling.
+	void enableBoundedMemory(
+		std::function<void(std::string const&)> _contractCompiled,
+		std::set<std::string> _keptASTs = std::set<std::string>{}
+	);
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -230,6 +251,7 @@ public:
 	std::string const& yulIR(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// Throws if eWasm was generated without enableOptimizedIROutput().
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the eWasm text representation of a contract.
@@ -258,6 +280,14 @@ public:
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
+	/// @returns the source mapping of the bytecode in the compact binary encoding or a nullptr
+	/// if the contract does not (yet) have bytecode.
+	bytes const* binarySourceMapping(std::string const& _contractName) const;
+
+	/// @returns the source mapping of the runtime bytecode in the compact binary encoding or a
+	/// nullptr if the contract does not (yet) have bytecode.
+	bytes const* runtimeBinarySourceMapping(std::string const& _contractName) const;
+
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
@@ -301,6 +331,7 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		bool astReleased = false; ///< Set if the AST was released in the bounded-memory mode.
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -318,7 +349,10 @@ private:
 		eth::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		eth::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Parsed and optimized experimental Yul IR code. Released after eWasm generation.
+		std::shared_ptr<yul::AssemblyStack> yulIRStack;
+		/// Optimized experimental Yul IR code. Only printed when requested.
+		mutable std::unique_ptr<std::string const> yulIROptimized;
 		std::string eWasm; ///< Experimental eWasm text representation
 		eth::LinkerObject eWasmObject; ///< Experimental eWasm code
 		mutable std::unique_ptr<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -328,6 +362,9 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		mutable std::unique_ptr<bytes const> binarySourceMapping;
+		mutable std::unique_ptr<bytes const> runtimeBinarySourceMapping;
+		bool released = false; ///< Set if the contract was released in the bounded-memory mode.
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -351,6 +388,9 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Releases everything that is stored for @a _contract in the bounded-memory mode.
+	void releaseContract(Contract& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -383,6 +423,9 @@ private:
 	/// @returns the computer source mapping string.
 	std::string computeSourceMapping(eth::AssemblyItems const& _items) const;
 
+	/// @returns the source mapping of @a _items in the compact binary encoding.
+	bytes computeBinarySourceMapping(eth::AssemblyItems const& _items) const;
+
 	/// @returns the contract ABI as a JSON object.
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
 	Json::Value const& contractABI(Contract const&) const;
@@ -416,6 +459,11 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
 	bool m_generateEWasm;
+	bool m_outputOptimizedIR;
+	/// Called for each compiled contract in the bounded-memory mode, unset otherwise.
+	std::function<void(std::string const&)> m_contractCompiled;
+	/// Sources whose ASTs are kept in the bounded-memory mode.
+	std::set<std::string> m_keptASTs;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -426,7 +474,7 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 
 namespace dev
 {
@@ -31,6 +32,25 @@ namespace solidity
 
 struct OptimiserSettings
 {
+	/// Step sequence of the Yul optimiser, see yul::OptimiserSuite::stepNameToAbbreviationMap
+	/// for the abbreviations. The part in brackets is repeated until the code size is stable.
+	static char constexpr DefaultYulOptimiserSteps[] =
+		"dhfoDgvufnTUtnIf"              // None of these can make stack problems worse
+		"["
+			"xarrscLM"                  // Turn into SSA and simplify
+			"cCTUtTOntnfDIu"            // Perform structural simplification
+			"Lcu"                       // Simplify again
+			"Vcujj"                     // Reverse SSA
+			"eu"                        // Run functional expression inliner
+			"xaruru"                    // Prune a bit more in SSA
+			"xarrcL"                    // Turn into SSA again and simplify
+			"gvif"                      // Run full inliner
+			"CTUcarrLsTOtfDncarrIuc"    // SSA plus simplify
+		"]"
+		"jmujuju"                       // Make source short and pretty
+		"VcTOcu"
+		"jmu";
+
 	/// No optimisations at all - not recommended.
 	static OptimiserSettings none()
 	{
@@ -79,7 +99,9 @@ struct OptimiserSettings
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			optimizeStackLayout == _other.optimizeStackLayout &&
 			runYulOptimiser == _other.runYulOptimiser &&
+			yulOptimiserSteps == _other.yulOptimiserSteps &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -99,8 +121,13 @@ struct OptimiserSettings
 	bool runConstantOptimiser = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
+	/// Hand over the stack slot of a variable to the expression that reads it for the last time
+	/// instead of duplicating it. Only effective together with ``optimizeStackAllocation``.
+	bool optimizeStackLayout = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
+	/// Sequence of optimisation steps to be performed by the Yul optimiser.
+	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
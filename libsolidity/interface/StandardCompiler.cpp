@@ -25,7 +25,10 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
@@ -34,7 +37,13 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <array>
 #include <optional>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 using namespace dev;
@@ -162,6 +171,7 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	static set<string> explicitOnly{"evm.bytecode.sourceMapBinary", "evm.deployedBytecode.sourceMapBinary", "yulOptimizerReport"};
 	for (auto const& artifact: _outputSelection)
 		/// @TODO support sub-matching, e.g "evm" matches "evm.assembly"
 		if (artifact == _artifact)
@@ -169,7 +179,12 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _art
 		else if (artifact == "*")
 		{
 			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
-			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
+			// The binary source mappings repeat the information of the source mappings and
+			// the optimizer report slows down the optimizer, so they are never matched by "*".
+			if (
+				explicitOnly.count(_artifact) == 0 &&
+				(experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
+			)
 				return true;
 		}
 	return false;
@@ -233,9 +248,9 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"ir", "irOptimized",
 		"wast", "wasm", "ewasm.wast", "ewasm.wasm",
 		"evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes",
-		"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences",
+		"evm.deployedBytecode.sourceMap", "evm.deployedBytecode.sourceMapBinary", "evm.deployedBytecode.linkReferences",
 		"evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap",
-		"evm.bytecode.linkReferences",
+		"evm.bytecode.sourceMapBinary", "evm.bytecode.linkReferences",
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	};
 
@@ -282,6 +297,22 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the optimized Yul IR was requested. Note that as an exception, '*' does not
+/// yet match "irOptimized"
+bool isOptimizedIRRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "irOptimized")
+					return true;
+
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -309,12 +340,18 @@ Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkRefere
 	return ret;
 }
 
-Json::Value collectEVMObject(eth::LinkerObject const& _object, string const* _sourceMap)
+Json::Value collectEVMObject(
+	eth::LinkerObject const& _object,
+	string const* _sourceMap,
+	bytes const* _binarySourceMap = nullptr
+)
 {
 	Json::Value output = Json::objectValue;
 	output["object"] = _object.toHex();
 	output["opcodes"] = dev::eth::disassemble(_object.bytecode);
 	output["sourceMap"] = _sourceMap ? *_sourceMap : "";
+	if (_binarySourceMap)
+		output["sourceMapBinary"] = toHex(*_binarySourceMap);
 	output["linkReferences"] = formatLinkReferences(_object.linkReferences);
 	return output;
 }
@@ -351,7 +388,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"boundedMemory", "parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -481,15 +518,145 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "stackLayout", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackLayout", settings.optimizeStackLayout))
+				return *error;
+			if (details["yulDetails"].isMember("optimizerSteps"))
+			{
+				Json::Value const& steps = details["yulDetails"]["optimizerSteps"];
+				if (!steps.isString())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.optimizerSteps\" must be a string.");
+				try
+				{
+					yul::OptimiserSuite::validateSequence(steps.asString());
+				}
+				catch (yul::OptimizerException const& _exception)
+				{
+					return formatFatalError(
+						"JSONError",
+						"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": " +
+						*boost::get_error_info<errinfo_comment>(_exception)
+					);
+				}
+				settings.yulOptimiserSteps = steps.asString();
+			}
 		}
 	}
 	return { std::move(settings) };
 }
 
+/// @returns the peak resident set size of the process in bytes or zero if it is not
+/// available on this platform. This is the peak over the lifetime of the process, so it
+/// includes earlier compilations in the same process.
+size_t processPeakMemoryUsage()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return size_t(usage.ru_maxrss);
+#else
+	// Linux reports kilobytes.
+	return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// @returns the statistics that are added to the output in the bounded-memory mode.
+Json::Value statistics()
+{
+	Json::Value statistics(Json::objectValue);
+	statistics["processPeakMemory"] = Json::UInt64(processPeakMemoryUsage());
+	return statistics;
+}
+
+/// Stream buffer that passes everything written to it on to an output sink in chunks.
+class OutputSinkBuffer: public std::streambuf
+{
+public:
+	explicit OutputSinkBuffer(StandardCompiler::OutputSink const& _sink): m_sink(_sink)
+	{
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+	}
+	~OutputSinkBuffer() override { sync(); }
+
+protected:
+	int_type overflow(int_type _c) override
+	{
+		sync();
+		if (!traits_type::eq_int_type(_c, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(_c);
+			pbump(1);
+		}
+		return traits_type::not_eof(_c);
+	}
+	int sync() override
+	{
+		if (pptr() != pbase())
+			m_sink(string(pbase(), pptr()));
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+		return 0;
+	}
+
+private:
+	StandardCompiler::OutputSink const& m_sink;
+	std::array<char, 0x10000> m_buffer;
+};
+
+/// Writes a JSON object to an output sink piece by piece, in the format of jsonCompactPrint.
+/// Members have to be added in the order in which jsoncpp sorts object keys.
+class JsonObjectWriter
+{
+public:
+	explicit JsonObjectWriter(StandardCompiler::OutputSink const& _sink): m_sink(_sink) { m_sink("{"); }
+
+	/// Adds a member whose value is serialized in one go.
+	void member(string const& _key, Json::Value const& _value)
+	{
+		key(_key);
+		m_sink(jsonCompactPrint(_value));
+	}
+	/// Adds a member whose value is already serialized in the format of jsonCompactPrint.
+	void serializedMember(string const& _key, string const& _value)
+	{
+		key(_key);
+		m_sink(_value);
+	}
+	/// Adds a member whose value is written to the output sink by @a _writeValue through a stream.
+	void streamedMember(string const& _key, std::function<void(ostream&)> const& _writeValue)
+	{
+		key(_key);
+		OutputSinkBuffer buffer(m_sink);
+		ostream stream(&buffer);
+		_writeValue(stream);
+	}
+	/// Adds a member whose value is an object that is written piece by piece using the returned writer.
+	/// No further members can be added to this object before the returned writer is closed.
+	JsonObjectWriter nestedObject(string const& _key)
+	{
+		key(_key);
+		return JsonObjectWriter(m_sink);
+	}
+	void close() { m_sink("}"); }
+
+private:
+	void key(string const& _key)
+	{
+		m_sink((m_empty ? "" : ",") + jsonCompactPrint(Json::Value(_key)) + ":");
+		m_empty = false;
+	}
+
+	StandardCompiler::OutputSink const& m_sink;
+	bool m_empty = true;
+};
+
 }
 
 boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -633,6 +800,13 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
 	}
 
+	if (settings.isMember("boundedMemory"))
+	{
+		if (!settings["boundedMemory"].isBool())
+			return formatFatalError("JSONError", "\"settings.boundedMemory\" must be a Boolean.");
+		ret.boundedMemory = settings["boundedMemory"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -723,7 +897,7 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputSink const& _sink)
 {
 	CompilerStack compilerStack(m_readFile);
 
@@ -743,13 +917,141 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	compilerStack.enableEWasmGeneration(isEWasmRequested(_inputsAndSettings.outputSelection));
 
+	compilerStack.enableOptimizedIROutput(isOptimizedIRRequested(_inputsAndSettings.outputSelection));
+
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
+	bool const wildcardMatchesExperimental = false;
+
+	auto contractOutput = [&](string const& contractName, string const& file, string const& name, bool compiled)
+	{
+		// ABI, storage layout, documentation and metadata
+		Json::Value contractData(Json::objectValue);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+			contractData["abi"] = compilerStack.contractABI(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
+			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+			contractData["metadata"] = compilerStack.metadata(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+			contractData["userdoc"] = compilerStack.natspecUser(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+
+		// IR
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+			contractData["ir"] = compilerStack.yulIR(contractName);
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+
+		// eWasm
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+			contractData["ewasm"]["wast"] = compilerStack.eWasm(contractName);
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
+			contractData["ewasm"]["wasm"] = compilerStack.eWasmObject(contractName).toHex();
+
+		// EVM
+		Json::Value evmData(Json::objectValue);
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
+		if (compiled && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+
+		if (compiled && isArtifactRequested(
+			_inputsAndSettings.outputSelection,
+			file,
+			name,
+			{
+				"evm.bytecode",
+				"evm.bytecode.object",
+				"evm.bytecode.opcodes",
+				"evm.bytecode.sourceMap",
+				"evm.bytecode.sourceMapBinary",
+				"evm.bytecode.linkReferences"
+			},
+			wildcardMatchesExperimental
+		))
+			evmData["bytecode"] = collectEVMObject(
+				compilerStack.object(contractName),
+				compilerStack.sourceMapping(contractName),
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.bytecode.sourceMapBinary", false) ?
+					compilerStack.binarySourceMapping(contractName) :
+					nullptr
+			);
+
+		if (compiled && isArtifactRequested(
+			_inputsAndSettings.outputSelection,
+			file,
+			name,
+			{
+				"evm.deployedBytecode",
+				"evm.deployedBytecode.object",
+				"evm.deployedBytecode.opcodes",
+				"evm.deployedBytecode.sourceMap",
+				"evm.deployedBytecode.sourceMapBinary",
+				"evm.deployedBytecode.linkReferences"
+			},
+			wildcardMatchesExperimental
+		))
+			evmData["deployedBytecode"] = collectEVMObject(
+				compilerStack.runtimeObject(contractName),
+				compilerStack.runtimeSourceMapping(contractName),
+				isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.deployedBytecode.sourceMapBinary", false) ?
+					compilerStack.runtimeBinarySourceMapping(contractName) :
+					nullptr
+			);
+
+		if (!evmData.empty())
+			contractData["evm"] = evmData;
+
+		return contractData;
+	};
+
+	// In the bounded-memory mode, the outputs of the contracts are generated while compiling,
+	// as the compiler stack releases everything stored for a contract right afterwards.
+	// They are serialized right away if the output is streamed.
+	map<string, Json::Value> compiledContractsOutput;
+	map<string, string> serializedContractsOutput;
+
 	try
 	{
-		if (binariesRequested)
+		if (binariesRequested && _inputsAndSettings.boundedMemory)
+		{
+			if (compilerStack.parseAndAnalyze())
+			{
+				set<string> keptASTs;
+				for (string const& sourceName: compilerStack.sourceNames())
+					if (
+						isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental) ||
+						isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental)
+					)
+						keptASTs.insert(sourceName);
+				compilerStack.enableBoundedMemory([&](string const& _contractName) {
+					size_t colon = _contractName.rfind(':');
+					solAssert(colon != string::npos, "");
+					Json::Value contractData = contractOutput(
+						_contractName,
+						_contractName.substr(0, colon),
+						_contractName.substr(colon + 1),
+						true
+					);
+					if (!_sink)
+						compiledContractsOutput[_contractName] = std::move(contractData);
+					else if (contractData.empty())
+						serializedContractsOutput[_contractName] = string();
+					else
+						serializedContractsOutput[_contractName] = jsonCompactPrint(contractData);
+				}, std::move(keptASTs));
+				compilerStack.compile();
+			}
+		}
+		else if (binariesRequested)
 			compilerStack.compile();
 		else
 			compilerStack.parseAndAnalyze();
@@ -875,11 +1177,85 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
 
-	bool const wildcardMatchesExperimental = false;
+	// Contracts grouped by file, in the order in which they appear in the output.
+	map<string, map<string, string>> contractsByFile;
+	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		contractsByFile[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
+	vector<string> const sourceNames = analysisPerformed ? compilerStack.sourceNames() : vector<string>();
+
+	if (_sink)
+	{
+		// The members are written in the order in which jsoncpp sorts object keys,
+		// so that the output is identical to printing the whole document at once.
+		JsonObjectWriter document(_sink);
+		if (output.isMember("auxiliaryInputRequested"))
+			document.member("auxiliaryInputRequested", output["auxiliaryInputRequested"]);
+
+		std::optional<JsonObjectWriter> contractsWriter;
+		for (auto const& [file, contracts]: contractsByFile)
+		{
+			std::optional<JsonObjectWriter> fileWriter;
+			for (auto const& [name, contractName]: contracts)
+			{
+				string contractData;
+				if (auto it = serializedContractsOutput.find(contractName); it != serializedContractsOutput.end())
+					contractData = std::move(it->second);
+				else if (Json::Value data = contractOutput(contractName, file, name, compilationSuccess); !data.empty())
+					contractData = jsonCompactPrint(data);
+				if (contractData.empty())
+					continue;
+				if (!fileWriter)
+				{
+					if (!contractsWriter)
+						contractsWriter.emplace(document.nestedObject("contracts"));
+					fileWriter.emplace(contractsWriter->nestedObject(file));
+				}
+				fileWriter->serializedMember(name, contractData);
+			}
+			if (fileWriter)
+				fileWriter->close();
+		}
+		if (contractsWriter)
+			contractsWriter->close();
+
+		if (output.isMember("errors"))
+			document.member("errors", output["errors"]);
+
+		JsonObjectWriter sourcesWriter = document.nestedObject("sources");
+		unsigned sourceIndex = 0;
+		for (string const& sourceName: sourceNames)
+		{
+			// The ASTs are written directly to the sink, without building their json trees.
+			auto writeAST = [&](bool _legacy)
+			{
+				return [&, _legacy](ostream& _stream)
+				{
+					ASTJsonConverter(_legacy, compilerStack.sourceIndices()).printCompact(_stream, compilerStack.ast(sourceName));
+				};
+			};
+			JsonObjectWriter sourceWriter = sourcesWriter.nestedObject(sourceName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				sourceWriter.streamedMember("ast", writeAST(false));
+			sourceWriter.member("id", sourceIndex++);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
+				sourceWriter.streamedMember("legacyAST", writeAST(true));
+			sourceWriter.close();
+		}
+		sourcesWriter.close();
+
+		if (_inputsAndSettings.boundedMemory)
+			document.member("statistics", statistics());
+		document.close();
+		return Json::nullValue;
+	}
 
 	output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisPerformed ? compilerStack.sourceNames() : vector<string>())
+	for (string const& sourceName: sourceNames)
 	{
 		Json::Value sourceResult = Json::objectValue;
 		sourceResult["id"] = sourceIndex++;
@@ -891,86 +1267,27 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	}
 
 	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
-	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// eWasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.eWasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.eWasmObject(contractName).toHex();
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" },
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName)
-			);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" },
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName)
-			);
-
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
-
-		if (!contractData.empty())
+	for (auto const& [file, contracts]: contractsByFile)
+		for (auto const& [name, contractName]: contracts)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			Json::Value contractData;
+			if (auto it = compiledContractsOutput.find(contractName); it != compiledContractsOutput.end())
+				contractData = std::move(it->second);
+			else
+				contractData = contractOutput(contractName, file, name, compilationSuccess);
+			if (!contractData.empty())
+			{
+				if (!contractsOutput.isMember(file))
+					contractsOutput[file] = Json::objectValue;
+				contractsOutput[file][name] = contractData;
+			}
 		}
-	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (_inputsAndSettings.boundedMemory)
+		output["statistics"] = statistics();
+
 	return output;
 }
 
@@ -1029,8 +1346,23 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "ir", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["ir"] = stack.print();
 
+	bool const optimizerReportRequested =
+		isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "yulOptimizerReport", wildcardMatchesExperimental);
+	stack.collectOptimiserStatistics(optimizerReportRequested);
 	stack.optimize();
 
+	if (optimizerReportRequested)
+	{
+		Json::Value report(Json::objectValue);
+		for (auto const& [name, step]: stack.optimiserStatistics().steps)
+		{
+			report[name]["runs"] = Json::UInt64(step.runs);
+			report[name]["microseconds"] = Json::Int64(step.duration.count());
+			report[name]["codeSizeChange"] = Json::Int64(step.codeSizeChange);
+		}
+		output["contracts"][sourceName][contractName]["yulOptimizerReport"] = report;
+	}
+
 	MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
 
 	if (isArtifactRequested(
@@ -1052,8 +1384,15 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, OutputSink());
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, OutputSink const& _sink) noexcept
 {
 	YulStringRepository::reset();
+	// Like the caches reset together with the Yul strings, do not keep this one across inputs.
+	dev::eth::ComputeMethod::clearCache();
 
 	try
 	{
@@ -1062,7 +1401,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _sink);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1113,3 +1452,40 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
+
+bool StandardCompiler::compile(string const& _input, OutputSink const& _sink) noexcept
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (!jsonParseStrict(_input, input, &errors))
+		{
+			_sink(jsonCompactPrint(formatFatalError("JSONError", errors)));
+			return true;
+		}
+	}
+	catch (...)
+	{
+		_sink("{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}");
+		return true;
+	}
+
+	bool outputStarted = false;
+	Json::Value output = compile(input, [&](string const& _part) {
+		outputStarted = true;
+		_sink(_part);
+	});
+	if (outputStarted)
+		return output.isNull();
+
+	try
+	{
+		_sink(jsonCompactPrint(output));
+	}
+	catch (...)
+	{
+		_sink("{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}");
+	}
+	return true;
+}
@@ -24,6 +24,7 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <functional>
 #include <optional>
 #include <boost/variant.hpp>
 
@@ -40,6 +41,9 @@ namespace solidity
 class StandardCompiler: boost::noncopyable
 {
 public:
+	/// Receives consecutive pieces of serialized JSON output.
+	using OutputSink = std::function<void(std::string const&)>;
+
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
@@ -54,6 +58,14 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Parses input as JSON and performs the above processing steps, but passes the serialized
+	/// output to @a _sink piece by piece instead of returning it: the output of each contract
+	/// and each source is generated and handed out one at a time, so the full output document
+	/// is never held in memory. The concatenation of the pieces is identical to the return value
+	/// of the function above. @a _sink must not throw.
+	/// @returns false if an internal error occurred after output has been passed to @a _sink,
+	/// in which case the output is incomplete.
+	bool compile(std::string const& _input, OutputSink const& _sink) noexcept;
 
 private:
 	struct InputsAndSettings
@@ -61,6 +73,7 @@ private:
 		std::string language;
 		Json::Value errors;
 		bool parserErrorRecovery = false;
+		bool boundedMemory = false;
 		std::map<std::string, std::string> sources;
 		std::map<h256, std::string> smtLib2Responses;
 		langutil::EVMVersion evmVersion;
@@ -75,7 +88,16 @@ private:
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the processing steps of the public function of the same signature. If @a _sink
+	/// is given, the output of Solidity compilations is streamed to it where possible and
+	/// a null value is returned. If output was already passed to @a _sink when an error
+	/// occurs, the returned error is not part of the streamed output.
+	Json::Value compile(Json::Value const& _input, OutputSink const& _sink) noexcept;
+
+	/// Compiles Solidity sources. If @a _sink is given, the output is passed to it
+	/// piece by piece and a null value is returned, unless compilation failed before
+	/// the output could be generated.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, OutputSink const& _sink);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
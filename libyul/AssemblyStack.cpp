@@ -35,6 +35,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/wasm/EWasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEWasmTranslator.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
@@ -44,6 +45,8 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 
+#include <boost/algorithm/string/case_conv.hpp>
+
 using namespace std;
 using namespace langutil;
 using namespace yul;
@@ -67,6 +70,32 @@ Dialect const& languageToDialect(AssemblyStack::Language _language, EVMVersion _
 	return Dialect::yul();
 }
 
+/**
+ * Replaces each instruction in functional notation by a call to the builtin function
+ * of the same name.
+ */
+class BuiltinCallConverter: public ASTModifier
+{
+public:
+	using ASTModifier::operator();
+	void visit(Expression& _expression) override
+	{
+		ASTModifier::visit(_expression);
+		if (auto* instruction = std::get_if<FunctionalInstruction>(&_expression))
+		{
+			FunctionCall call{
+				instruction->location,
+				Identifier{
+					instruction->location,
+					YulString{boost::to_lower_copy(dev::eth::instructionInfo(instruction->instruction).name)}
+				},
+				std::move(instruction->arguments)
+			};
+			_expression = std::move(call);
+		}
+	}
+};
+
 }
 
 
@@ -103,6 +132,17 @@ void AssemblyStack::optimize()
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
+void AssemblyStack::convertToBuiltinCalls()
+{
+	yulAssert(m_language == Language::StrictAssembly, "");
+	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
+
+	m_analysisSuccessful = false;
+	yulAssert(m_parserResult, "");
+	convertToBuiltinCalls(*m_parserResult);
+	yulAssert(analyzeParsed(), "Invalid source code after conversion to builtin calls.");
+}
+
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 {
 	if (m_language == _targetLanguage)
@@ -148,6 +188,15 @@ bool AssemblyStack::analyzeParsed(Object& _object)
 	return success;
 }
 
+void AssemblyStack::convertToBuiltinCalls(Object& _object)
+{
+	yulAssert(_object.code, "");
+	BuiltinCallConverter{}(*_object.code);
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			convertToBuiltinCalls(*subObject);
+}
+
 void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _optimize) const
 {
 	EVMDialect const* dialect = nullptr;
@@ -161,7 +210,14 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 	else
 		yulAssert(false, "Invalid language.");
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_evm15,
+		_optimize,
+		m_optimiserSettings.optimizeStackLayout
+	);
 }
 
 void AssemblyStack::optimize(Object& _object, bool _isCreation)
@@ -180,7 +236,10 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		dialect,
 		meter.get(),
 		_object,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		m_collectOptimiserStatistics ? &m_optimiserStatistics : nullptr
 	);
 }
 
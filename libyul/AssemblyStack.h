@@ -26,6 +26,7 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -81,6 +82,11 @@ public:
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Replaces instructions in functional notation, which the optimizer can introduce,
+	/// by calls to the corresponding builtin functions, i.e. brings the code into the form
+	/// the parser produces for strict assembly. Can only be used with strict assembly.
+	void convertToBuiltinCalls();
+
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
 
@@ -96,6 +102,15 @@ public:
 	/// Return the parsed and analyzed object.
 	std::shared_ptr<Object> parserResult() const;
 
+	/// Enables collecting the run time and code size change of the Yul optimiser steps run by
+	/// optimize(). Disabled by default, because measuring the code size after each step slows
+	/// down the optimiser.
+	void collectOptimiserStatistics(bool _enable = true) { m_collectOptimiserStatistics = _enable; }
+
+	/// @returns the run time and code size change of the Yul optimiser steps run by optimize(),
+	/// summed over all objects and all calls. Only filled if enabled via collectOptimiserStatistics().
+	OptimiserStepStatistics const& optimiserStatistics() const { return m_optimiserStatistics; }
+
 private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
@@ -103,10 +118,13 @@ private:
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
 	void optimize(yul::Object& _object, bool _isCreation);
+	void convertToBuiltinCalls(yul::Object& _object);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	dev::solidity::OptimiserSettings m_optimiserSettings;
+	bool m_collectOptimiserStatistics = false;
+	OptimiserStepStatistics m_optimiserStatistics;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
@@ -167,3 +167,14 @@ inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
 }
 
 }
+
+namespace std
+{
+template<> struct hash<yul::YulString>
+{
+	size_t operator()(yul::YulString const& _x) const
+	{
+		return static_cast<size_t>(_x.hash());
+	}
+};
+}
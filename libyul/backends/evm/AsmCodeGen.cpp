@@ -185,7 +185,8 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess const& _identifierAccess,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	bool _optimizeStackLayout
 )
 {
 	EthAssemblyAdapter assemblyAdapter(_assembly);
@@ -199,7 +200,8 @@ void CodeGenerator::assemble(
 		_optimizeStackAllocation,
 		false,
 		_identifierAccess,
-		_useNamedLabelsForFunctions
+		_useNamedLabelsForFunctions,
+		_optimizeStackLayout
 	);
 	try
 	{
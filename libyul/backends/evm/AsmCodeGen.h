@@ -83,7 +83,8 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		bool _optimizeStackLayout = false
 	);
 };
 
@@ -102,6 +102,7 @@ CodeTransform::CodeTransform(
 	bool _evm15,
 	ExternalIdentifierAccess const& _identifierAccess,
 	bool _useNamedLabelsForFunctions,
+	bool _optimizeStackLayout,
 	int _stackAdjustment,
 	shared_ptr<Context> _context
 ):
@@ -112,6 +113,7 @@ CodeTransform::CodeTransform(
 	m_allowStackOpt(_allowStackOpt),
 	m_evm15(_evm15),
 	m_useNamedLabelsForFunctions(_useNamedLabelsForFunctions),
+	m_optimizeStackLayout(_optimizeStackLayout),
 	m_identifierAccess(_identifierAccess),
 	m_stackAdjustment(_stackAdjustment),
 	m_context(_context)
@@ -173,6 +175,35 @@ void CodeTransform::deleteVariable(Scope::Variable const& _var)
 	m_variablesScheduledForDeletion.erase(&_var);
 }
 
+bool CodeTransform::consumeVariable(Scope::Variable const& _var, YulString _name)
+{
+	if (!m_allowStackOpt || !m_optimizeStackLayout || m_insideForLoopCondition)
+		return false;
+
+	auto declaration = m_scope->identifiers.find(_name);
+	if (
+		declaration == m_scope->identifiers.end() ||
+		std::get_if<Scope::Variable>(&declaration->second) != &_var
+	)
+		return false;
+
+	auto references = m_context->variableReferences.find(&_var);
+	if (references == m_context->variableReferences.end() || references->second != 1)
+		return false;
+
+	auto height = m_context->variableStackHeights.find(&_var);
+	if (height == m_context->variableStackHeights.end() || height->second != m_assembly.stackHeight() - 1)
+		return false;
+
+	// The slot is now owned by the expression and will be removed together with it.
+	// The matching increase of the stack adjustment happens when the block is finalized.
+	m_context->variableStackHeights.erase(height);
+	m_context->variableReferences.erase(references);
+	--m_stackAdjustment;
+	++m_consumedVariables;
+	return true;
+}
+
 void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 {
 	yulAssert(m_scope, "");
@@ -181,7 +212,9 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 	int height = m_assembly.stackHeight();
 	if (_varDecl.value)
 	{
+		unsigned const consumedBefore = m_consumedVariables;
 		std::visit(*this, *_varDecl.value);
+		height -= int(m_consumedVariables - consumedBefore);
 		expectDeposit(numVariables, height);
 	}
 	else
@@ -244,8 +277,9 @@ void CodeTransform::stackError(StackTooDeepError _error, int _targetStackHeight)
 void CodeTransform::operator()(Assignment const& _assignment)
 {
 	int height = m_assembly.stackHeight();
+	unsigned const consumedBefore = m_consumedVariables;
 	std::visit(*this, *_assignment.value);
-	expectDeposit(_assignment.variableNames.size(), height);
+	expectDeposit(_assignment.variableNames.size(), height - int(m_consumedVariables - consumedBefore));
 
 	m_assembly.setSourceLocation(_assignment.location);
 	generateMultiAssignment(_assignment.variableNames);
@@ -366,8 +400,8 @@ void CodeTransform::operator()(Identifier const& _identifier)
 	if (m_scope->lookup(_identifier.name, GenericVisitor{
 		[=](Scope::Variable& _var)
 		{
-			// TODO: opportunity for optimization: Do not DUP if this is the last reference
-			// to the top most element of the stack
+			if (consumeVariable(_var, _identifier.name))
+				return;
 			if (int heightDiff = variableHeightDiff(_var, _identifier.name, false))
 				m_assembly.appendInstruction(dev::eth::dupInstruction(heightDiff));
 			else
@@ -523,6 +557,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 			m_evm15,
 			m_identifierAccess,
 			m_useNamedLabelsForFunctions,
+			m_optimizeStackLayout,
 			localStackAdjustment,
 			m_context
 		)(_function.body);
@@ -610,7 +645,9 @@ void CodeTransform::operator()(ForLoop const& _forLoop)
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendLabel(loopStart);
 
+	m_insideForLoopCondition = true;
 	visitExpression(*_forLoop.condition);
+	m_insideForLoopCondition = false;
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendInstruction(dev::eth::Instruction::ISZERO);
 	m_assembly.appendJumpToIf(loopEnd);
@@ -719,8 +756,9 @@ AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope:
 void CodeTransform::visitExpression(Expression const& _expression)
 {
 	int height = m_assembly.stackHeight();
+	unsigned const consumedBefore = m_consumedVariables;
 	std::visit(*this, _expression);
-	expectDeposit(1, height);
+	expectDeposit(1, height - int(m_consumedVariables - consumedBefore));
 }
 
 void CodeTransform::visitStatements(vector<Statement> const& _statements)
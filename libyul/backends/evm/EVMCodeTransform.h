@@ -114,6 +114,9 @@ public:
 	/// given assembly.
 	/// Throws StackTooDeepError if a variable is not accessible or if a function has too
 	/// many parameters.
+	/// @param _optimizeStackLayout if set (and @a _allowStackOpt is set as well), the last
+	/// reference to a variable that sits on top of the stack consumes its slot instead of
+	/// duplicating it.
 	CodeTransform(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
@@ -123,7 +126,8 @@ public:
 		bool _allowStackOpt = false,
 		bool _evm15 = false,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
-		bool _useNamedLabelsForFunctions = false
+		bool _useNamedLabelsForFunctions = false,
+		bool _optimizeStackLayout = false
 	): CodeTransform(
 		_assembly,
 		_analysisInfo,
@@ -134,6 +138,7 @@ public:
 		_evm15,
 		_identifierAccess,
 		_useNamedLabelsForFunctions,
+		_optimizeStackLayout,
 		_assembly.stackHeight(),
 		nullptr
 	)
@@ -155,6 +160,7 @@ protected:
 		bool _evm15,
 		ExternalIdentifierAccess const& _identifierAccess,
 		bool _useNamedLabelsForFunctions,
+		bool _optimizeStackLayout,
 		int _stackAdjustment,
 		std::shared_ptr<Context> _context
 	);
@@ -167,6 +173,11 @@ protected:
 	void freeUnusedVariables();
 	/// Marks the stack slot of @a _var to be reused.
 	void deleteVariable(Scope::Variable const& _var);
+	/// If @a _var is declared in the current scope, occupies the topmost stack slot and
+	/// is referenced for the last time, removes it from the variable bookkeeping so that
+	/// its slot is taken over by the expression currently being generated.
+	/// @returns true if the variable was consumed that way.
+	bool consumeVariable(Scope::Variable const& _var, YulString _name);
 
 public:
 	void operator()(Instruction const& _instruction);
@@ -230,6 +241,14 @@ private:
 	bool const m_allowStackOpt = true;
 	bool const m_evm15 = false;
 	bool const m_useNamedLabelsForFunctions = false;
+	bool const m_optimizeStackLayout = false;
+	/// True while the condition of a for loop is generated. The condition is evaluated
+	/// repeatedly, so variables referenced there must not be consumed.
+	bool m_insideForLoopCondition = false;
+	/// Number of variables whose stack slot was taken over by an expression.
+	/// Stack heights recorded before generating an expression are corrected by the
+	/// number of variables consumed while generating it.
+	unsigned m_consumedVariables = 0;
 	ExternalIdentifierAccess m_identifierAccess;
 	/// Adjustment between the stack height as determined during the analysis phase
 	/// and the stack height in the assembly. This is caused by an initial stack being present
@@ -29,9 +29,16 @@
 using namespace yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	bool _optimizeStackLayout
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
+	EVMObjectCompiler compiler(_assembly, _dialect, _evm15, _optimizeStackLayout);
 	compiler.run(_object, _optimize);
 }
 
@@ -45,7 +52,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 		{
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize, m_optimizeStackLayout);
 		}
 		else
 		{
@@ -57,7 +64,18 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	yulAssert(_object.code, "No code.");
 	// We do not catch and re-throw the stack too deep exception here because it is a YulException,
 	// which should be native to this part of the code.
-	CodeTransform transform{m_assembly, *_object.analysisInfo, *_object.code, m_dialect, context, _optimize, m_evm15};
+	CodeTransform transform{
+		m_assembly,
+		*_object.analysisInfo,
+		*_object.code,
+		m_dialect,
+		context,
+		_optimize,
+		m_evm15,
+		ExternalIdentifierAccess{},
+		false,
+		m_optimizeStackLayout
+	};
 	transform(*_object.code);
 	yulAssert(transform.stackErrors().empty(), "Stack errors present but not thrown.");
 }
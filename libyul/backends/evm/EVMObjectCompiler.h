@@ -29,10 +29,17 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize);
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		bool _optimize,
+		bool _optimizeStackLayout = false
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15):
-		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15)
+	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimizeStackLayout):
+		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15), m_optimizeStackLayout(_optimizeStackLayout)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -40,6 +47,7 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	bool m_evm15 = false;
+	bool m_optimizeStackLayout = false;
 };
 
 }
@@ -25,6 +25,8 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <unordered_map>
+
 using namespace std;
 using namespace yul;
 using namespace dev;
@@ -33,11 +35,6 @@ using namespace yul::wasm;
 namespace
 {
 
-bytes toBytes(uint8_t _b)
-{
-	return bytes(1, _b);
-}
-
 enum class Section: uint8_t
 {
 	CUSTOM = 0x00,
@@ -50,11 +47,6 @@ enum class Section: uint8_t
 	CODE = 0x0a
 };
 
-bytes toBytes(Section _s)
-{
-	return toBytes(uint8_t(_s));
-}
-
 enum class ValueType: uint8_t
 {
 	Void = 0x40,
@@ -63,61 +55,13 @@ enum class ValueType: uint8_t
 	I32 = 0x7f
 };
 
-bytes toBytes(ValueType _vt)
-{
-	return toBytes(uint8_t(_vt));
-}
-
 enum class Export: uint8_t
 {
 	Function = 0x0,
 	Memory = 0x2
 };
 
-bytes toBytes(Export _export)
-{
-	return toBytes(uint8_t(_export));
-}
-
-enum class Opcode: uint8_t
-{
-	Unreachable = 0x00,
-	Nop = 0x01,
-	Block = 0x02,
-	Loop = 0x03,
-	If = 0x04,
-	Else = 0x05,
-	Try = 0x06,
-	Catch = 0x07,
-	Throw = 0x08,
-	Rethrow = 0x09,
-	BrOnExn = 0x0a,
-	End = 0x0b,
-	Br = 0x0c,
-	BrIf = 0x0d,
-	BrTable = 0x0e,
-	Return = 0x0f,
-	Call = 0x10,
-	CallIndirect = 0x11,
-	ReturnCall = 0x12,
-	ReturnCallIndirect = 0x13,
-	Drop = 0x1a,
-	Select = 0x1b,
-	LocalGet = 0x20,
-	LocalSet = 0x21,
-	LocalTee = 0x22,
-	GlobalGet = 0x23,
-	GlobalSet = 0x24,
-	I32Const = 0x41,
-	I64Const = 0x42,
-};
-
-bytes toBytes(Opcode _o)
-{
-	return toBytes(uint8_t(_o));
-}
-
-static std::map<string, uint8_t> const builtins = {
+static std::unordered_map<string, uint8_t> const builtins = {
 	{"i32.load", 0x28},
 	{"i64.load", 0x29},
 	{"i32.load8_s", 0x2c},
@@ -202,40 +146,40 @@ static std::map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes lebEncode(uint64_t _n)
-{
-	bytes encoded;
-	while (_n > 0x7f)
-	{
-		encoded.emplace_back(uint8_t(0x80 | (_n & 0x7f)));
-		_n >>= 7;
-	}
-	encoded.emplace_back(_n);
-	return encoded;
-}
-
-bytes lebEncodeSigned(int64_t _n)
-{
-	if (_n >= 0 && _n < 0x40)
-		return toBytes(uint8_t(uint64_t(_n) & 0xff));
-	else if (-_n > 0 && -_n < 0x40)
-		return toBytes(uint8_t(uint64_t(_n + 0x80) & 0xff));
-	else
-		return toBytes(uint8_t(0x80 | uint8_t(_n & 0x7f))) + lebEncodeSigned(_n / 0x80);
-}
-
-bytes prefixSize(bytes _data)
-{
-	size_t size = _data.size();
-	return lebEncode(size) + std::move(_data);
 }
 
-bytes makeSection(Section _section, bytes _data)
+enum class BinaryTransform::Opcode: uint8_t
 {
-	return toBytes(_section) + prefixSize(std::move(_data));
-}
-
-}
+	Unreachable = 0x00,
+	Nop = 0x01,
+	Block = 0x02,
+	Loop = 0x03,
+	If = 0x04,
+	Else = 0x05,
+	Try = 0x06,
+	Catch = 0x07,
+	Throw = 0x08,
+	Rethrow = 0x09,
+	BrOnExn = 0x0a,
+	End = 0x0b,
+	Br = 0x0c,
+	BrIf = 0x0d,
+	BrTable = 0x0e,
+	Return = 0x0f,
+	Call = 0x10,
+	CallIndirect = 0x11,
+	ReturnCall = 0x12,
+	ReturnCallIndirect = 0x13,
+	Drop = 0x1a,
+	Select = 0x1b,
+	LocalGet = 0x20,
+	LocalSet = 0x21,
+	LocalTee = 0x22,
+	GlobalGet = 0x23,
+	GlobalSet = 0x24,
+	I32Const = 0x41,
+	I64Const = 0x42,
+};
 
 bytes BinaryTransform::run(Module const& _module)
 {
@@ -250,165 +194,166 @@ bytes BinaryTransform::run(Module const& _module)
 	for (FunctionDefinition const& fun: _module.functions)
 		bt.m_functions[fun.name] = funID++;
 
-	bytes ret{0, 'a', 's', 'm'};
+	bt.m_output = bytes{0, 'a', 's', 'm'};
 	// version
-	ret += bytes{1, 0, 0, 0};
-	ret += bt.typeSection(_module.imports, _module.functions);
-	ret += bt.importSection(_module.imports);
-	ret += bt.functionSection(_module.functions);
-	ret += bt.memorySection();
-	ret += bt.globalSection();
-	ret += bt.exportSection();
+	bt.m_output += bytes{1, 0, 0, 0};
+	bt.typeSection(_module.imports, _module.functions);
+	bt.importSection(_module.imports);
+	bt.functionSection(_module.functions);
+	bt.memorySection();
+	bt.globalSection();
+	bt.exportSection();
 	for (auto const& sub: _module.subModules)
 	{
 		// TODO should we prefix and / or shorten the name?
 		bytes data = BinaryTransform::run(sub.second);
 		size_t length = data.size();
-		ret += bt.customSection(sub.first, std::move(data));
-		bt.m_subModulePosAndSize[sub.first] = {ret.size() - length, length};
+		bt.customSection(sub.first, data);
+		bt.m_subModulePosAndSize[sub.first] = {bt.m_output.size() - length, length};
 	}
-	ret += bt.codeSection(_module.functions);
-	return ret;
+	bt.codeSection(_module.functions);
+	return std::move(bt.m_output);
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return toBytes(Opcode::I64Const) + lebEncodeSigned(_literal.value);
+	appendOpcode(Opcode::I64Const);
+	appendLebSigned(_literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// TODO is this used?
 	yulAssert(false, "String literals not yet implemented");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	appendOpcode(Opcode::LocalGet);
+	appendLeb(m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globals.at(_variable.name));
+	appendOpcode(Opcode::GlobalGet);
+	appendLeb(m_globals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
 	if (_call.functionName == "dataoffset")
 	{
 		string name = std::get<StringLiteral>(_call.arguments.at(0)).value;
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(m_subModulePosAndSize.at(name).first);
+		appendOpcode(Opcode::I64Const);
+		appendLebSigned(m_subModulePosAndSize.at(name).first);
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = std::get<StringLiteral>(_call.arguments.at(0)).value;
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(m_subModulePosAndSize.at(name).second);
+		appendOpcode(Opcode::I64Const);
+		appendLebSigned(m_subModulePosAndSize.at(name).second);
 	}
-
-	bytes args = visit(_call.arguments);
-
-	if (_call.functionName == "unreachable")
-			return toBytes(Opcode::Unreachable);
+	else if (_call.functionName == "unreachable")
+		appendOpcode(Opcode::Unreachable);
 	else
 	{
-		yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
-		bytes ret = std::move(args) + toBytes(builtins.at(_call.functionName));
+		auto builtin = builtins.find(_call.functionName);
+		yulAssert(builtin != builtins.end(), "Builtin " + _call.functionName + " not found");
+		visit(_call.arguments);
+		m_output.push_back(builtin->second);
 		if (
 			_call.functionName.find(".load") != string::npos ||
 			_call.functionName.find(".store") != string::npos
 		)
 			// alignment and offset
-			ret += bytes{{3, 0}};
-		return ret;
+			m_output += bytes{{3, 0}};
 	}
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functions.at(_call.functionName));
+	visit(_call.arguments);
+	appendOpcode(Opcode::Call);
+	appendLeb(m_functions.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	appendOpcode(Opcode::LocalSet);
+	appendLeb(m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	appendOpcode(Opcode::GlobalSet);
+	appendLeb(m_globals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	appendOpcode(Opcode::If);
+	m_output.push_back(uint8_t(ValueType::Void));
 
 	m_labels.push({});
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		appendOpcode(Opcode::Else);
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop();
 
-	result += toBytes(Opcode::End);
-	return result;
+	appendOpcode(Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	appendOpcode(Opcode::Loop);
+	m_output.push_back(uint8_t(ValueType::Void));
 
 	m_labels.push(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop();
 
-	result += toBytes(Opcode::End);
-	return result;
+	appendOpcode(Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Break const&)
+void BinaryTransform::operator()(Break const&)
 {
 	yulAssert(false, "br not yet implemented.");
 	// TODO the index is just the nesting depth.
-	return {};
 }
 
-bytes BinaryTransform::operator()(BreakIf const&)
+void BinaryTransform::operator()(BreakIf const&)
 {
 	yulAssert(false, "br_if not yet implemented.");
 	// TODO the index is just the nesting depth.
-	return {};
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
-	return
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	appendOpcode(Opcode::Block);
+	m_output.push_back(uint8_t(ValueType::Void));
+	visit(_block.statements);
+	appendOpcode(Opcode::End);
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
+	size_t start = beginSizePrefixed();
 
 	// This is a kind of run-length-encoding of local types. Has to be adapted once
 	// we have locals of different types.
-	ret += lebEncode(1); // number of locals groups
-	ret += lebEncode(_function.locals.size());
-	ret += toBytes(ValueType::I64);
+	appendLeb(1); // number of locals groups
+	appendLeb(_function.locals.size());
+	m_output.push_back(uint8_t(ValueType::I64));
 
 	m_locals.clear();
 	size_t varIdx = 0;
@@ -417,10 +362,10 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 	for (size_t i = 0; i < _function.locals.size(); ++i)
 		m_locals[_function.locals[i].variableName] = varIdx++;
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	appendOpcode(Opcode::End);
 
-	return prefixSize(std::move(ret));
+	endSizePrefixed(start);
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -459,7 +404,7 @@ vector<uint8_t> BinaryTransform::encodeTypes(vector<string> const& _typeNames)
 	return result;
 }
 
-bytes BinaryTransform::typeSection(
+void BinaryTransform::typeSection(
 	vector<FunctionImport> const& _imports,
 	vector<FunctionDefinition> const& _functions
 )
@@ -470,113 +415,186 @@ bytes BinaryTransform::typeSection(
 	for (auto const& fun: _functions)
 		types[typeOf(fun)].emplace_back(fun.name);
 
-	bytes result;
+	size_t start = beginSection(uint8_t(Section::TYPE));
+	appendLeb(types.size());
 	size_t index = 0;
 	for (auto const& [type, funNames]: types)
 	{
 		for (string const& name: funNames)
 			m_functionTypes[name] = index;
-		result += toBytes(ValueType::Function);
-		result += lebEncode(type.first.size()) + type.first;
-		result += lebEncode(type.second.size()) + type.second;
+		m_output.push_back(uint8_t(ValueType::Function));
+		appendLeb(type.first.size());
+		m_output += type.first;
+		appendLeb(type.second.size());
+		m_output += type.second;
 
 		index++;
 	}
-
-	return makeSection(Section::TYPE, lebEncode(index) + std::move(result));
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::importSection(
+void BinaryTransform::importSection(
 	vector<FunctionImport> const& _imports
 )
 {
-	bytes result = lebEncode(_imports.size());
+	size_t start = beginSection(uint8_t(Section::IMPORT));
+	appendLeb(_imports.size());
 	for (FunctionImport const& import: _imports)
 	{
 		uint8_t importKind = 0; // function
-		result +=
-			encodeName(import.module) +
-			encodeName(import.externalName) +
-			toBytes(importKind) +
-			lebEncode(m_functionTypes[import.internalName]);
+		appendName(import.module);
+		appendName(import.externalName);
+		m_output.push_back(importKind);
+		appendLeb(m_functionTypes[import.internalName]);
 	}
-	return makeSection(Section::IMPORT, std::move(result));
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::functionSection(vector<FunctionDefinition> const& _functions)
+void BinaryTransform::functionSection(vector<FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	size_t start = beginSection(uint8_t(Section::FUNCTION));
+	appendLeb(_functions.size());
 	for (auto const& fun: _functions)
-		result += lebEncode(m_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, std::move(result));
+		appendLeb(m_functionTypes.at(fun.name));
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::memorySection()
+void BinaryTransform::memorySection()
 {
-	bytes result = lebEncode(1);
-	result.push_back(0); // flags
-	result.push_back(1); // initial
-	return makeSection(Section::MEMORY, std::move(result));
+	size_t start = beginSection(uint8_t(Section::MEMORY));
+	appendLeb(1);
+	m_output.push_back(0); // flags
+	m_output.push_back(1); // initial
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::globalSection()
+void BinaryTransform::globalSection()
 {
-	bytes result = lebEncode(m_globals.size());
+	size_t start = beginSection(uint8_t(Section::GLOBAL));
+	appendLeb(m_globals.size());
 	for (size_t i = 0; i < m_globals.size(); ++i)
-		result +=
-			// mutable i64
-			bytes{uint8_t(ValueType::I64), 1} +
-			toBytes(Opcode::I64Const) +
-			lebEncodeSigned(0) +
-			toBytes(Opcode::End);
-
-	return makeSection(Section::GLOBAL, std::move(result));
+	{
+		// mutable i64
+		m_output += bytes{uint8_t(ValueType::I64), 1};
+		appendOpcode(Opcode::I64Const);
+		appendLebSigned(0);
+		appendOpcode(Opcode::End);
+	}
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::exportSection()
+void BinaryTransform::exportSection()
 {
-	bytes result = lebEncode(2);
-	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
-	result += encodeName("main") + toBytes(Export::Function) + lebEncode(m_functions.at("main"));
-	return makeSection(Section::EXPORT, std::move(result));
+	size_t start = beginSection(uint8_t(Section::EXPORT));
+	appendLeb(2);
+	appendName("memory");
+	m_output.push_back(uint8_t(Export::Memory));
+	appendLeb(0);
+	appendName("main");
+	m_output.push_back(uint8_t(Export::Function));
+	appendLeb(m_functions.at("main"));
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+void BinaryTransform::customSection(string const& _name, bytes const& _data)
 {
-	bytes result = encodeName(_name) + std::move(_data);
-	return makeSection(Section::CUSTOM, std::move(result));
+	size_t start = beginSection(uint8_t(Section::CUSTOM));
+	appendName(_name);
+	m_output += _data;
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+void BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	size_t start = beginSection(uint8_t(Section::CODE));
+	appendLeb(_functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, std::move(result));
+		(*this)(fun);
+	endSizePrefixed(start);
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | boost::adaptors::reversed)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
+}
+
+void BinaryTransform::appendOpcode(Opcode _opcode)
+{
+	m_output.push_back(uint8_t(_opcode));
+}
+
+void BinaryTransform::appendLeb(uint64_t _n)
+{
+	while (_n > 0x7f)
+	{
+		m_output.push_back(uint8_t(0x80 | (_n & 0x7f)));
+		_n >>= 7;
+	}
+	m_output.push_back(uint8_t(_n));
+}
+
+void BinaryTransform::appendLebSigned(int64_t _n)
+{
+	while (true)
+		if (_n >= 0 && _n < 0x40)
+		{
+			m_output.push_back(uint8_t(uint64_t(_n) & 0xff));
+			return;
+		}
+		else if (-_n > 0 && -_n < 0x40)
+		{
+			m_output.push_back(uint8_t(uint64_t(_n + 0x80) & 0xff));
+			return;
+		}
+		else
+		{
+			m_output.push_back(uint8_t(0x80 | uint8_t(_n & 0x7f)));
+			_n /= 0x80;
+		}
 }
 
-bytes BinaryTransform::encodeName(std::string const& _name)
+void BinaryTransform::appendName(std::string const& _name)
 {
 	// UTF-8 is allowed here by the Wasm spec, but since all names here should stem from
 	// Solidity or Yul identifiers or similar, non-ascii characters ending up here
 	// is a very bad sign.
 	for (char c: _name)
 		yulAssert(uint8_t(c) <= 0x7f, "Non-ascii character found.");
-	return lebEncode(_name.size()) + asBytes(_name);
+	appendLeb(_name.size());
+	m_output += asBytes(_name);
+}
+
+size_t BinaryTransform::beginSection(uint8_t _section)
+{
+	m_output.push_back(_section);
+	return beginSizePrefixed();
+}
+
+size_t BinaryTransform::beginSizePrefixed()
+{
+	// Reserve a single byte for the size, which suffices for sizes below 128.
+	m_output.push_back(0);
+	return m_output.size();
+}
+
+void BinaryTransform::endSizePrefixed(size_t _start)
+{
+	size_t size = m_output.size() - _start;
+	uint8_t encoded[10];
+	size_t length = 0;
+	while (size > 0x7f)
+	{
+		encoded[length++] = uint8_t(0x80 | (size & 0x7f));
+		size >>= 7;
+	}
+	encoded[length++] = uint8_t(size);
+	m_output[_start - 1] = encoded[0];
+	m_output.insert(m_output.begin() + ptrdiff_t(_start), encoded + 1, encoded + length);
 }
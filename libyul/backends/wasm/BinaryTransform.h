@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <stack>
+#include <unordered_map>
 
 namespace yul
 {
@@ -40,50 +41,65 @@ class BinaryTransform
 public:
 	static dev::bytes run(Module const& _module);
 
-	dev::bytes operator()(wasm::Literal const& _literal);
-	dev::bytes operator()(wasm::StringLiteral const& _literal);
-	dev::bytes operator()(wasm::LocalVariable const& _identifier);
-	dev::bytes operator()(wasm::GlobalVariable const& _identifier);
-	dev::bytes operator()(wasm::BuiltinCall const& _builinCall);
-	dev::bytes operator()(wasm::FunctionCall const& _functionCall);
-	dev::bytes operator()(wasm::LocalAssignment const& _assignment);
-	dev::bytes operator()(wasm::GlobalAssignment const& _assignment);
-	dev::bytes operator()(wasm::If const& _if);
-	dev::bytes operator()(wasm::Loop const& _loop);
-	dev::bytes operator()(wasm::Break const& _break);
-	dev::bytes operator()(wasm::BreakIf const& _break);
-	dev::bytes operator()(wasm::Block const& _block);
-	dev::bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Break const& _break);
+	void operator()(wasm::BreakIf const& _break);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
+	enum class Opcode: uint8_t;
+
 	using Type = std::pair<std::vector<std::uint8_t>, std::vector<std::uint8_t>>;
 	static Type typeOf(wasm::FunctionImport const& _import);
 	static Type typeOf(wasm::FunctionDefinition const& _funDef);
 
 	static uint8_t encodeType(std::string const& _typeName);
 	static std::vector<uint8_t> encodeTypes(std::vector<std::string> const& _typeNames);
-	dev::bytes typeSection(
+	void typeSection(
 		std::vector<wasm::FunctionImport> const& _imports,
 		std::vector<wasm::FunctionDefinition> const& _functions
 	);
 
-	dev::bytes importSection(std::vector<wasm::FunctionImport> const& _imports);
-	dev::bytes functionSection(std::vector<wasm::FunctionDefinition> const& _functions);
-	dev::bytes memorySection();
-	dev::bytes globalSection();
-	dev::bytes exportSection();
-	dev::bytes customSection(std::string const& _name, dev::bytes _data);
-	dev::bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
-
-	dev::bytes visit(std::vector<wasm::Expression> const& _expressions);
-	dev::bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
-
-	static dev::bytes encodeName(std::string const& _name);
-
-	std::map<std::string, size_t> m_locals;
-	std::map<std::string, size_t> m_globals;
-	std::map<std::string, size_t> m_functions;
-	std::map<std::string, size_t> m_functionTypes;
+	void importSection(std::vector<wasm::FunctionImport> const& _imports);
+	void functionSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	void memorySection();
+	void globalSection();
+	void exportSection();
+	void customSection(std::string const& _name, dev::bytes const& _data);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
+
+	void appendOpcode(Opcode _opcode);
+	void appendLeb(uint64_t _n);
+	void appendLebSigned(int64_t _n);
+	void appendName(std::string const& _name);
+
+	/// Appends the section id and starts a size-prefixed part, see beginSizePrefixed.
+	size_t beginSection(uint8_t _section);
+	/// Starts a part of the output that is prefixed by its size in bytes.
+	/// @returns the position of the part, to be passed to endSizePrefixed.
+	size_t beginSizePrefixed();
+	/// Writes the size of the part started at @a _start into the space reserved in front of it.
+	void endSizePrefixed(size_t _start);
+
+	/// All parts of the module are appended to this buffer.
+	dev::bytes m_output;
+	std::unordered_map<std::string, size_t> m_locals;
+	std::unordered_map<std::string, size_t> m_globals;
+	std::unordered_map<std::string, size_t> m_functions;
+	std::unordered_map<std::string, size_t> m_functionTypes;
 	std::stack<std::string> m_labels;
 	std::map<std::string, std::pair<size_t, size_t>> m_subModulePosAndSize;
 };
@@ -692,8 +692,7 @@ function invalid() {
 
 Object EVMToEWasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	Polyfill const& polyfillCode = parsedPolyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -707,8 +706,8 @@ Object EVMToEWasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
+	NameDisplacer{nameDispenser, polyfillCode.functions}(ast);
+	for (auto const& st: polyfillCode.code->statements)
 		ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
@@ -738,12 +737,17 @@ Object EVMToEWasmTranslator::run(Object const& _object)
 	return ret;
 }
 
-void EVMToEWasmTranslator::parsePolyfill()
+EVMToEWasmTranslator::Polyfill const& EVMToEWasmTranslator::parsedPolyfill()
 {
+	static unique_ptr<Polyfill> cached;
+	static YulStringRepository::ResetCallback callback{[&] { cached.reset(); }};
+	if (cached)
+		return *cached;
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(polyfill, ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
 	if (!errors.empty())
 	{
 		string message;
@@ -752,8 +756,9 @@ void EVMToEWasmTranslator::parsePolyfill()
 		yulAssert(false, message);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	cached = make_unique<Polyfill>();
+	for (auto const& statement: code->statements)
+		cached->functions.insert(std::get<FunctionDefinition>(statement).name);
+	cached->code = move(code);
+	return *cached;
 }
-
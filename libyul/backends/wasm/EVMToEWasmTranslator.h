@@ -35,12 +35,18 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	/// Code of the polyfill and the names of the functions it defines.
+	struct Polyfill
+	{
+		std::shared_ptr<Block const> code;
+		std::set<YulString> functions;
+	};
 
-	Dialect const& m_dialect;
+	/// @returns the polyfill. It is parsed only once per process (or after the YulString
+	/// repository was reset) and copied into every translated object.
+	static Polyfill const& parsedPolyfill();
 
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
+	Dialect const& m_dialect;
 };
 
 }
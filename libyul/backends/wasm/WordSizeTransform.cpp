@@ -364,10 +364,11 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 
 array<YulString, 4> WordSizeTransform::generateU64IdentifierNames(YulString const& _s)
 {
-	yulAssert(m_variableMapping.find(_s) == m_variableMapping.end(), "");
+	auto [it, inserted] = m_variableMapping.emplace(_s, array<YulString, 4>{});
+	yulAssert(inserted, "");
 	for (int i = 0; i < 4; i++)
-		m_variableMapping[_s][i] = m_nameDispenser.newName(YulString{_s.str() + "_" + to_string(i)});
-	return m_variableMapping[_s];
+		it->second[i] = m_nameDispenser.newName(YulString{_s.str() + "_" + to_string(i)});
+	return it->second;
 }
 
 array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const& _e)
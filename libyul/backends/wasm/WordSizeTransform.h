@@ -26,6 +26,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace yul
@@ -96,7 +97,7 @@ private:
 	Dialect const& m_inputDialect;
 	NameDispenser& m_nameDispenser;
 	/// maps original u256 variable's name to corresponding u64 variables' names
-	std::map<YulString, std::array<YulString, 4>> m_variableMapping;
+	std::unordered_map<YulString, std::array<YulString, 4>> m_variableMapping;
 };
 
 }
@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
@@ -89,16 +90,57 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& var: m_value)
-		{
-			assertThrow(var.second, OptimizerException, "");
-			assertThrow(inScope(var.first), OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *var.second))
+		auto candidates = m_variablesByValueHash.find(ExpressionHasher::run(_e));
+		if (candidates != m_variablesByValueHash.end())
+			for (YulString variable: candidates->second)
 			{
-				_e = Identifier{locationOf(_e), var.first};
-				break;
+				Expression const* value = m_value.at(variable);
+				assertThrow(value, OptimizerException, "");
+				assertThrow(inScope(variable), OptimizerException, "");
+				if (SyntacticallyEqual{}(_e, *value))
+				{
+					_e = Identifier{locationOf(_e), variable};
+					break;
+				}
 			}
-		}
 	}
 }
+
+void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
+{
+	// The values of variables outside of the function are not available inside
+	// and are restored afterwards, so the index is saved and restored as well.
+	map<uint64_t, set<YulString>> variablesByValueHash;
+	map<YulString, uint64_t> valueHashes;
+	swap(m_variablesByValueHash, variablesByValueHash);
+	swap(m_valueHashes, valueHashes);
+
+	DataFlowAnalyzer::operator()(_fun);
+
+	swap(m_variablesByValueHash, variablesByValueHash);
+	swap(m_valueHashes, valueHashes);
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	eraseValue(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
+
+	uint64_t hash = ExpressionHasher::run(*_value);
+	m_valueHashes[_variable] = hash;
+	m_variablesByValueHash[hash].insert(_variable);
+}
+
+void CommonSubexpressionEliminator::eraseValue(YulString _variable)
+{
+	DataFlowAnalyzer::eraseValue(_variable);
+
+	auto it = m_valueHashes.find(_variable);
+	if (it == m_valueHashes.end())
+		return;
+	auto candidates = m_variablesByValueHash.find(it->second);
+	candidates->second.erase(_variable);
+	if (candidates->second.empty())
+		m_variablesByValueHash.erase(candidates);
+	m_valueHashes.erase(it);
+}
@@ -50,7 +50,18 @@ private:
 
 protected:
 	using ASTModifier::visit;
+	using DataFlowAnalyzer::operator();
 	void visit(Expression& _e) override;
+	void operator()(FunctionDefinition&) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+	void eraseValue(YulString _variable) override;
+
+private:
+	/// Variables in m_value, indexed by the hash of their current value.
+	std::map<uint64_t, std::set<YulString>> m_variablesByValueHash;
+	/// Hashes of the current values of the variables in m_value.
+	std::map<YulString, uint64_t> m_valueHashes;
 };
 
 }
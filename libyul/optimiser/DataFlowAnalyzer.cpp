@@ -103,8 +103,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	InvertibleMap<YulString, YulString> storage = m_storage;
-	InvertibleMap<YulString, YulString> memory = m_memory;
+	size_t storage = m_storage.takeSnapshot();
+	size_t memory = m_memory.takeSnapshot();
 
 	ASTModifier::operator()(_if);
 
@@ -122,8 +122,8 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		InvertibleMap<YulString, YulString> storage = m_storage;
-		InvertibleMap<YulString, YulString> memory = m_memory;
+		size_t storage = m_storage.takeSnapshot();
+		size_t memory = m_memory.takeSnapshot();
 		(*this)(_case.body);
 		joinKnowledge(storage, memory);
 
@@ -217,7 +217,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		movableChecker.visit(*_value);
 	else
 		for (auto const& var: _variables)
-			m_value[var] = &m_zero;
+			assignValue(var, &m_zero);
 
 	if (_value && _variables.size() == 1)
 	{
@@ -225,7 +225,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		// Expression has to be movable and cannot contain a reference
 		// to the variable that will be assigned to.
 		if (movableChecker.movable() && !movableChecker.referencedVariables().count(name))
-			m_value[name] = _value;
+			assignValue(name, _value);
 	}
 
 	auto const& referencedVariables = movableChecker.referencedVariables();
@@ -291,11 +291,21 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
-		m_value.erase(name);
+		eraseValue(name);
 	for (auto const& name: _variables)
 		m_references.eraseKey(name);
 }
 
+void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value)
+{
+	m_value[_variable] = _value;
+}
+
+void DataFlowAnalyzer::eraseValue(YulString _variable)
+{
+	m_value.erase(_variable);
+}
+
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
@@ -314,10 +324,7 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 		m_memory.clear();
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	InvertibleMap<YulString, YulString> const& _olderStorage,
-	InvertibleMap<YulString, YulString> const& _olderMemory
-)
+void DataFlowAnalyzer::joinKnowledge(size_t _olderStorage, size_t _olderMemory)
 {
 	joinKnowledgeHelper(m_storage, _olderStorage);
 	joinKnowledgeHelper(m_memory, _olderMemory);
@@ -325,22 +332,21 @@ void DataFlowAnalyzer::joinKnowledge(
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
 	InvertibleMap<YulString, YulString>& _this,
-	InvertibleMap<YulString, YulString> const& _older
+	size_t _older
 )
 {
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	set<YulString> keysToErase;
-	for (auto const& item: _this.values)
+	// Keys that have not been changed since the snapshot still have their older value.
+	for (auto const& [key, olderValue]: _this.changesSince(_older))
 	{
-		auto it = _older.values.find(item.first);
-		if (it == _older.values.end() || it->second != item.second)
-			keysToErase.insert(item.first);
+		auto it = _this.values.find(key);
+		if (it != _this.values.end() && (!olderValue || *olderValue != it->second))
+			_this.eraseKey(key);
 	}
-	for (auto const& key: keysToErase)
-		_this.eraseKey(key);
+	_this.releaseSnapshot();
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -106,23 +106,28 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
+	/// Sets the current value of the variable in m_value. Derived classes
+	/// can override this to keep additional indices of m_value in sync.
+	virtual void assignValue(YulString _variable, Expression const* _value);
+
+	/// Removes the current value of the variable (if it has one) from m_value.
+	virtual void eraseValue(YulString _variable);
+
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		InvertibleMap<YulString, YulString> const& _olderStorage,
-		InvertibleMap<YulString, YulString> const& _olderMemory
-	);
+	/// Joins knowledge about storage and memory with an older point in the control-flow,
+	/// given by snapshots of m_storage and m_memory, and releases the snapshots.
+	/// This only works if the current state is a direct successor of the older point.
+	/// Only the keys changed since the snapshots are inspected.
+	void joinKnowledge(size_t _olderStorage, size_t _olderMemory);
 
 	static void joinKnowledgeHelper(
 		InvertibleMap<YulString, YulString>& _thisData,
-		InvertibleMap<YulString, YulString> const& _olderData
+		size_t _olderData
 	);
 
 	/// Returns true iff the variable is in scope.
@@ -139,6 +144,8 @@ protected:
 	std::map<YulString, SideEffects> m_functionSideEffects;
 
 	/// Current values of variables, always movable.
+	/// Only modified through assignValue and eraseValue, except for saving and restoring
+	/// it around function definitions.
 	std::map<YulString, Expression const*> m_value;
 	/// m_references.forward[a].contains(b) <=> the current expression assigned to a references b
 	/// m_references.backward[b].contains(a) <=> the current expression assigned to a references b
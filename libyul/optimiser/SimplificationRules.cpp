@@ -49,14 +49,17 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	static SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
-	{
-		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-	}
-	return nullptr;
+	vector<Expression> const& arguments = *instruction->second;
+	return rules.m_rules[uint8_t(instruction->first)].findFirst(
+		arguments.size(),
+		[&](size_t _index) { return matchKey(arguments[_index], _dialect, _ssaValues); },
+		[&](SimplificationRule<Pattern> const& _rule) {
+			rules.resetMatchGroups();
+			return
+				_rule.pattern.matches(_expr, _dialect, _ssaValues) &&
+				(!_rule.feasible || _rule.feasible());
+		}
+	);
 }
 
 bool SimplificationRules::isInitialized() const
@@ -78,6 +81,32 @@ std::optional<std::pair<dev::eth::Instruction, vector<Expression> const*>>
 	return {};
 }
 
+MatchKey SimplificationRules::matchKey(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues
+)
+{
+	// Resolve the variable the same way Pattern::matches does for patterns that are not "Any".
+	Expression const* expr = &_expr;
+	if (holds_alternative<Identifier>(_expr))
+	{
+		auto it = _ssaValues.find(std::get<Identifier>(_expr).name);
+		if (it != _ssaValues.end() && it->second)
+			expr = it->second;
+	}
+
+	if (holds_alternative<Literal>(*expr))
+	{
+		Literal const& literal = std::get<Literal>(*expr);
+		if (literal.kind == LiteralKind::Number)
+			return MatchKey::constant(u256(literal.value.str()));
+	}
+	else if (auto instrAndArgs = instructionAndArguments(_dialect, *expr))
+		return MatchKey::operation(instrAndArgs->first);
+	return MatchKey::any();
+}
+
 void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _rules)
 {
 	for (auto const& r: _rules)
@@ -86,7 +115,7 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules[uint8_t(_rule.pattern.instruction())].add(_rule);
 }
 
 SimplificationRules::SimplificationRules()
@@ -120,8 +149,9 @@ yul::Pattern::Pattern(dev::eth::Instruction _instruction, initializer_list<Patte
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	assertThrow(0 < _group && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -184,7 +214,7 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if ((*m_matchGroups)[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
 			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
@@ -205,6 +235,19 @@ bool Pattern::matches(
 	return true;
 }
 
+MatchKey Pattern::matchKey() const
+{
+	switch (m_kind)
+	{
+	case PatternKind::Constant:
+		return m_data ? MatchKey::constant(*m_data) : MatchKey::constant();
+	case PatternKind::Operation:
+		return MatchKey::operation(m_instruction);
+	default:
+		return MatchKey::any();
+	}
+}
+
 dev::eth::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
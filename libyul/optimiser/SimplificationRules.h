@@ -29,6 +29,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -38,6 +39,10 @@ namespace yul
 struct Dialect;
 class Pattern;
 
+/// Expressions matched by the patterns of the match groups, indexed by match group.
+/// Index zero is unused, since it denotes "no match group".
+using MatchGroups = std::array<Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
  */
@@ -66,10 +71,16 @@ private:
 	void addRules(std::vector<dev::eth::SimplificationRule<Pattern>> const& _rules);
 	void addRule(dev::eth::SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	static dev::eth::MatchKey matchKey(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues
+	);
+
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules[256];
+	MatchGroups m_matchGroups{};
+	dev::eth::SimplificationRuleIndex<Pattern> m_rules[256];
 };
 
 enum class PatternKind
@@ -104,7 +115,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -113,6 +124,8 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	/// @returns what this pattern requires of the outermost item of an expression.
+	dev::eth::MatchKey matchKey() const;
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	dev::u256 d() const;
@@ -131,7 +144,7 @@ private:
 	std::shared_ptr<dev::u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 }
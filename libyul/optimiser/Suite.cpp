@@ -64,8 +64,11 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libdevcore/Assertions.h>
 #include <libdevcore/CommonData.h>
 
+#include <chrono>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -75,7 +78,9 @@ void OptimiserSuite::run(
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
+	string const& _optimisationSequence,
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserStepStatistics* _statistics
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -88,193 +93,17 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
-
-	suite.runSequence({
-		VarDeclInitializer::name,
-		FunctionHoister::name,
-		BlockFlattener::name,
-		ForLoopInitRewriter::name,
-		DeadCodeEliminator::name,
-		FunctionGrouper::name,
-		EquivalentFunctionCombiner::name,
-		UnusedPruner::name,
-		BlockFlattener::name,
-		ControlFlowSimplifier::name,
-		LiteralRematerialiser::name,
-		ConditionalUnsimplifier::name,
-		StructuralSimplifier::name,
-		ControlFlowSimplifier::name,
-		ForLoopConditionIntoBody::name,
-		BlockFlattener::name
-	}, ast);
-
-	// None of the above can make stack problems worse.
-
-	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
-	{
-		{
-			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
-			if (newSize == codeSize)
-				break;
-			codeSize = newSize;
-		}
-
-		{
-			// Turn into SSA and simplify
-			suite.runSequence({
-				ExpressionSplitter::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				ExpressionSimplifier::name,
-				CommonSubexpressionEliminator::name,
-				LoadResolver::name,
-				LoopInvariantCodeMotion::name
-			}, ast);
-		}
-
-		{
-			// perform structural simplification
-			suite.runSequence({
-				CommonSubexpressionEliminator::name,
-				ConditionalSimplifier::name,
-				LiteralRematerialiser::name,
-				ConditionalUnsimplifier::name,
-				StructuralSimplifier::name,
-				LiteralRematerialiser::name,
-				ForLoopConditionOutOfBody::name,
-				ControlFlowSimplifier::name,
-				StructuralSimplifier::name,
-				ControlFlowSimplifier::name,
-				BlockFlattener::name,
-				DeadCodeEliminator::name,
-				ForLoopConditionIntoBody::name,
-				UnusedPruner::name
-			}, ast);
-		}
-
-		{
-			// simplify again
-			suite.runSequence({
-				LoadResolver::name,
-				CommonSubexpressionEliminator::name,
-				UnusedPruner::name,
-			}, ast);
-		}
-
-		{
-			// reverse SSA
-			suite.runSequence({
-				SSAReverser::name,
-				CommonSubexpressionEliminator::name,
-				UnusedPruner::name,
-
-				ExpressionJoiner::name,
-				ExpressionJoiner::name,
-			}, ast);
-		}
-
-		// should have good "compilability" property here.
-
-		{
-			// run functional expression inliner
-			suite.runSequence({
-				ExpressionInliner::name,
-				UnusedPruner::name,
-			}, ast);
-		}
-
-		{
-			// Prune a bit more in SSA
-			suite.runSequence({
-				ExpressionSplitter::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				UnusedPruner::name,
-				RedundantAssignEliminator::name,
-				UnusedPruner::name,
-			}, ast);
-		}
-
-		{
-			// Turn into SSA again and simplify
-			suite.runSequence({
-				ExpressionSplitter::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				CommonSubexpressionEliminator::name,
-				LoadResolver::name,
-			}, ast);
-		}
-
-		{
-			// run full inliner
-			suite.runSequence({
-				FunctionGrouper::name,
-				EquivalentFunctionCombiner::name,
-				FullInliner::name,
-				BlockFlattener::name
-			}, ast);
-		}
-
-		{
-			// SSA plus simplify
-			suite.runSequence({
-				ConditionalSimplifier::name,
-				LiteralRematerialiser::name,
-				ConditionalUnsimplifier::name,
-				CommonSubexpressionEliminator::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				LoadResolver::name,
-				ExpressionSimplifier::name,
-				LiteralRematerialiser::name,
-				ForLoopConditionOutOfBody::name,
-				StructuralSimplifier::name,
-				BlockFlattener::name,
-				DeadCodeEliminator::name,
-				ControlFlowSimplifier::name,
-				CommonSubexpressionEliminator::name,
-				SSATransform::name,
-				RedundantAssignEliminator::name,
-				RedundantAssignEliminator::name,
-				ForLoopConditionIntoBody::name,
-				UnusedPruner::name,
-				CommonSubexpressionEliminator::name,
-			}, ast);
-		}
-	}
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _statistics);
 
-	// Make source short and pretty.
+	// Some steps depend on properties ensured by FunctionHoister, FunctionGrouper and
+	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
+	suite.runSequence("hgo", ast);
 
-	suite.runSequence({
-		ExpressionJoiner::name,
-		Rematerialiser::name,
-		UnusedPruner::name,
-		ExpressionJoiner::name,
-		UnusedPruner::name,
-		ExpressionJoiner::name,
-		UnusedPruner::name,
-
-		SSAReverser::name,
-		CommonSubexpressionEliminator::name,
-		LiteralRematerialiser::name,
-		ForLoopConditionOutOfBody::name,
-		CommonSubexpressionEliminator::name,
-		UnusedPruner::name,
-
-		ExpressionJoiner::name,
-		Rematerialiser::name,
-		UnusedPruner::name,
-	}, ast);
+	suite.runSequence(_optimisationSequence, ast);
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
-	suite.runSequence({
+	suite.runSequence(vector<string>{
 		FunctionGrouper::name
 	}, ast);
 	// We ignore the return value because we will get a much better error
@@ -308,7 +137,7 @@ void OptimiserSuite::run(
 		if (ast.statements.size() > 1 && std::get<Block>(ast.statements.front()).statements.empty())
 			ast.statements.erase(ast.statements.begin());
 	}
-	suite.runSequence({
+	suite.runSequence(vector<string>{
 		VarNameCleaner::name
 	}, ast);
 
@@ -372,6 +201,120 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 	return instance;
 }
 
+map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
+{
+	// The abbreviations are the same as in the interactive mode of yulopti.
+	// VarNameCleaner is missing on purpose: it is always run at the end.
+	static map<string, char> const lookupTable{
+		{BlockFlattener::name,                'f'},
+		{CommonSubexpressionEliminator::name, 'c'},
+		{ConditionalSimplifier::name,         'C'},
+		{ConditionalUnsimplifier::name,       'U'},
+		{ControlFlowSimplifier::name,         'n'},
+		{DeadCodeEliminator::name,            'D'},
+		{EquivalentFunctionCombiner::name,    'v'},
+		{ExpressionInliner::name,             'e'},
+		{ExpressionJoiner::name,              'j'},
+		{ExpressionSimplifier::name,          's'},
+		{ExpressionSplitter::name,            'x'},
+		{ForLoopConditionIntoBody::name,      'I'},
+		{ForLoopConditionOutOfBody::name,     'O'},
+		{ForLoopInitRewriter::name,           'o'},
+		{FullInliner::name,                   'i'},
+		{FunctionGrouper::name,               'g'},
+		{FunctionHoister::name,               'h'},
+		{LiteralRematerialiser::name,         'T'},
+		{LoadResolver::name,                  'L'},
+		{LoopInvariantCodeMotion::name,       'M'},
+		{RedundantAssignEliminator::name,     'r'},
+		{Rematerialiser::name,                'm'},
+		{SSAReverser::name,                   'V'},
+		{SSATransform::name,                  'a'},
+		{StructuralSimplifier::name,          't'},
+		{UnusedPruner::name,                  'u'},
+		{VarDeclInitializer::name,            'd'},
+	};
+	yulAssert(lookupTable.size() + 1 == allSteps().size(), "");
+	return lookupTable;
+}
+
+map<char, string> const& OptimiserSuite::stepAbbreviationToNameMap()
+{
+	static map<char, string> const lookupTable = []()
+	{
+		map<char, string> table;
+		for (auto const& [name, abbreviation]: stepNameToAbbreviationMap())
+		{
+			yulAssert(!table.count(abbreviation), "Duplicate step abbreviation.");
+			table[abbreviation] = name;
+		}
+		return table;
+	}();
+	return lookupTable;
+}
+
+void OptimiserSuite::validateSequence(string const& _stepAbbreviations)
+{
+	bool insideBrackets = false;
+	for (char abbreviation: _stepAbbreviations)
+		switch (abbreviation)
+		{
+		case ' ':
+		case '\n':
+			break;
+		case '[':
+			assertThrow(!insideBrackets, OptimizerException, "Nested brackets are not supported.");
+			insideBrackets = true;
+			break;
+		case ']':
+			assertThrow(insideBrackets, OptimizerException, "Unbalanced brackets.");
+			insideBrackets = false;
+			break;
+		default:
+			assertThrow(
+				stepAbbreviationToNameMap().count(abbreviation),
+				OptimizerException,
+				"'"s + abbreviation + "' is not a valid step abbreviation."
+			);
+		}
+	assertThrow(!insideBrackets, OptimizerException, "Unbalanced brackets.");
+}
+
+void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
+{
+	validateSequence(_stepAbbreviations);
+
+	vector<string> steps;
+	for (char abbreviation: _stepAbbreviations)
+		if (abbreviation == '[')
+		{
+			runSequence(steps, _ast);
+			steps.clear();
+		}
+		else if (abbreviation == ']')
+		{
+			runSequenceUntilStable(steps, _ast);
+			steps.clear();
+		}
+		else if (abbreviation != ' ' && abbreviation != '\n')
+			steps.emplace_back(stepAbbreviationToNameMap().at(abbreviation));
+	runSequence(steps, _ast);
+}
+
+void OptimiserSuite::runSequenceUntilStable(vector<string> const& _steps, Block& _ast)
+{
+	size_t codeSize = 0;
+	for (size_t rounds = 0; rounds < MaxRounds; ++rounds)
+	{
+		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		if (newSize == codeSize)
+			break;
+		codeSize = newSize;
+
+		runSequence(_steps, _ast);
+	}
+}
+
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
 	unique_ptr<Block> copy;
@@ -381,7 +324,22 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		if (m_statistics)
+		{
+			size_t sizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+			auto start = chrono::steady_clock::now();
+			allSteps().at(step)->run(m_context, _ast);
+			auto duration = chrono::steady_clock::now() - start;
+
+			OptimiserStepStatistics::Step& statistics = m_statistics->steps[step];
+			statistics.runs++;
+			statistics.duration += chrono::duration_cast<chrono::microseconds>(duration);
+			statistics.codeSizeChange +=
+				static_cast<long long>(CodeSize::codeSizeIncludingFunctions(_ast)) -
+				static_cast<long long>(sizeBefore);
+		}
+		else
+			allSteps().at(step)->run(m_context, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -26,6 +26,8 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <chrono>
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
@@ -38,6 +40,21 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Run time and code size changes of the optimiser steps, accumulated over all runs of each step.
+ */
+struct OptimiserStepStatistics
+{
+	struct Step
+	{
+		size_t runs = 0;
+		std::chrono::microseconds duration{0};
+		/// Sum of the changes in code size (as measured by CodeSize) caused by the step.
+		long long codeSizeChange = 0;
+	};
+	std::map<std::string, Step> steps;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
@@ -51,33 +68,57 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+	/// The maximum number of times a bracketed part of a step sequence is repeated.
+	static constexpr size_t MaxRounds = 12;
+
+	/// Runs the mandatory preparation steps, the steps given in @a _optimisationSequence and the
+	/// final stack compression and cleanup.
+	/// @param _optimisationSequence step abbreviations (see stepNameToAbbreviationMap), the part
+	/// in square brackets is repeated until the code size does not change anymore, at most
+	/// MaxRounds times. Whitespace is ignored.
+	/// @param _statistics if not null, the run time and code size change of each step is added.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::string const& _optimisationSequence,
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserStepStatistics* _statistics = nullptr
 	);
 
+	/// Throws OptimizerException if @a _stepAbbreviations is not a valid step sequence:
+	/// it may only contain step abbreviations, whitespace and at most one level of brackets.
+	static void validateSequence(std::string const& _stepAbbreviations);
+
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
+	void runSequence(std::string const& _stepAbbreviations, Block& _ast);
+	/// Runs @a _steps repeatedly until the code size does not change anymore, at most
+	/// MaxRounds times.
+	void runSequenceUntilStable(std::vector<std::string> const& _steps, Block& _ast);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
+	static std::map<std::string, char> const& stepNameToAbbreviationMap();
+	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
 	OptimiserSuite(
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		OptimiserStepStatistics* _statistics = nullptr
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_debug(_debug),
+		m_statistics(_statistics)
 	{}
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	OptimiserStepStatistics* m_statistics = nullptr;
 };
 
 }
@@ -35,6 +35,8 @@
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -50,6 +52,8 @@
 #include <libdevcore/JSON.h>
 
 #include <memory>
+#include <set>
+#include <string_view>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -123,6 +127,8 @@ static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
+static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerReport = "yul-optimizer-report";
 static string const g_strIR = "ir";
 static string const g_strEWasm = "ewasm";
 static string const g_strLicense = "license";
@@ -667,6 +673,16 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_strYulOptimizations.c_str(),
+			po::value<string>()->value_name("steps"),
+			"Forces the Yul optimizer to use the specified sequence of optimization steps instead of the built-in one. "
+			"The part in square brackets is repeated until the code size does not change anymore."
+		)
+		(
+			g_strYulOptimizerReport.c_str(),
+			"In assembly mode, report the run time and the code size change of each Yul optimizer step."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -875,8 +891,11 @@ bool CommandLineInterface::processInput()
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
-		return true;
+		bool complete = compiler.compile(input, [](string const& _part) { sout() << _part; });
+		sout() << endl;
+		if (!complete)
+			serr() << "Internal error while writing the output, the output is incomplete." << endl;
+		return complete;
 	}
 
 	if (!readInputFilesAndConfigureRemappings())
@@ -899,7 +918,34 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
-	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
+	if (m_args.count(g_strYulOptimizations))
+	{
+		if (!m_args.count(g_argOptimize) && !m_args.count(g_strOptimizeYul))
+		{
+			serr() << "--" << g_strYulOptimizations << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
+		try
+		{
+			yul::OptimiserSuite::validateSequence(m_args[g_strYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizations << ": ";
+			serr() << *boost::get_error_info<errinfo_comment>(_exception) << endl;
+			return false;
+		}
+	}
+
+	bool const assemblyMode = m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul);
+
+	if (m_args.count(g_strYulOptimizerReport) && !assemblyMode)
+	{
+		serr() << "--" << g_strYulOptimizerReport << " is only valid in assembly mode." << endl;
+		return false;
+	}
+
+	if (assemblyMode)
 	{
 		// switch to assembly mode
 		m_onlyAssemble = true;
@@ -995,6 +1041,8 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (m_args.count(g_strYulOptimizations))
+			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		m_compiler->setOptimiserSettings(settings);
 
 		bool successful = m_compiler->compile();
@@ -1234,53 +1282,70 @@ bool CommandLineInterface::actOnInput()
 
 bool CommandLineInterface::link()
 {
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
+	// Map from how the libraries will be named inside the bytecode to the hex representation
+	// of their addresses. It is computed once and shared by all files that are linked.
+	map<string, string, less<>> librariesReplacements;
+	// Hints that are appended to binary object files for the libraries above.
+	set<string, less<>> libraryHints;
 	int const placeholderSize = 40; // 20 bytes or 40 hex characters
 	for (auto const& library: m_libraries)
 	{
 		string const& name = library.first;
+		string addressHex = toHex(library.second.asBytes());
 		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
 		// This leaves 36 characters for the library identifier. The identifier used to
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + eth::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		librariesReplacements["__" + eth::LinkerObject::libraryPlaceholder(name) + "__"] = addressHex;
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = addressHex;
+
+		libraryHints.insert(libraryPlaceholderHint(name));
 	}
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string& code = src.second;
+		// Library hints are comments after the bytecode and do not contain placeholders.
+		auto end = code.begin() + ptrdiff_t(min(code.find("\n//"), code.size()));
+		for (auto it = code.begin(); it != end;)
 		{
-			while (it != end && *it != '_') ++it;
+			it = find(it, end, '_');
 			if (it == end) break;
 			if (end - it < placeholderSize)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (end - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << src.first << " at position " << (end - code.begin()) << endl;
 				return false;
 			}
 
-			string name(it, it + placeholderSize);
-			if (librariesReplacements.count(name))
-			{
-				string hexStr(toHex(librariesReplacements.at(name).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
+			string_view name(&*it, placeholderSize);
+			auto replacement = librariesReplacements.find(name);
+			if (replacement != librariesReplacements.end())
+				copy(replacement->second.begin(), replacement->second.end(), it);
 			else
 				serr() << "Reference \"" << name << "\" in file \"" << src.first << "\" still unresolved." << endl;
 			it += placeholderSize;
 		}
 		// Remove hints for resolved libraries.
-		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+		if (end != code.end() && !libraryHints.empty())
+		{
+			string linked(code.begin(), end);
+			for (auto lineStart = end; lineStart != code.end();)
+			{
+				auto lineEnd = find(next(lineStart), code.end(), '\n');
+				string_view line(code.data() + (lineStart - code.begin()) + 1, size_t(lineEnd - lineStart) - 1);
+				if (!libraryHints.count(line))
+					linked.append(lineStart, lineEnd);
+				lineStart = lineEnd;
+			}
+			code = move(linked);
+		}
+		while (!code.empty() && code.back() == '\n')
+			code.pop_back();
 	}
 	return true;
 }
@@ -1328,13 +1393,17 @@ bool CommandLineInterface::assemble(
 {
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
+	OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+	if (m_args.count(g_strYulOptimizations))
+		settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 	for (auto const& src: m_sourceCodes)
 	{
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
 			m_evmVersion,
 			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
+			settings
 		);
+		stack.collectOptimiserStatistics(m_args.count(g_strYulOptimizerReport));
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -1406,6 +1475,17 @@ bool CommandLineInterface::assemble(
 			sout() << stack.print() << endl;
 		}
 
+		if (m_args.count(g_strYulOptimizerReport))
+		{
+			sout() << endl << "Optimizer steps:" << endl;
+			for (auto const& [name, step]: stack.optimiserStatistics().steps)
+				sout() <<
+					"  " << name << ": " <<
+					step.runs << " runs, " <<
+					step.duration.count() << " us, code size " <<
+					(step.codeSizeChange > 0 ? "+" : "") << step.codeSizeChange << endl;
+		}
+
 		yul::MachineAssemblyObject object;
 		try
 		{
@@ -363,6 +363,24 @@ SOLTMPDIR=$(mktemp -d)
 )
 rm -rf "$SOLTMPDIR"
 
+printTask "Testing linking several files at once..."
+SOLTMPDIR=$(mktemp -d)
+(
+    cd "$SOLTMPDIR"
+    set -e
+    echo 'library L_1 { function f() public pure {} } library L_2 { function f() public pure {} } contract C { function f() public pure { L_1.f(); } } contract D { function f() public pure { L_1.f(); } } contract E { function f() public pure { L_1.f(); L_2.f(); } }' > x.sol
+    "$SOLC" --bin -o . x.sol 2>/dev/null
+    "$SOLC" --link --libraries x.sol:L_1:0x90f20564390eAe531E810af625A22f51385Cd222 C.bin D.bin E.bin &>/dev/null
+    # The placeholders and explanations should be gone in all fully linked files.
+    ! grep -q '[/_]' C.bin || exit 1
+    ! grep -q '[/_]' D.bin || exit 1
+    # Only the placeholder and explanation of the unlinked library should remain.
+    ! grep -q 'x.sol:L_1' E.bin || exit 1
+    grep -q '__\$[0-9a-f]*\$__' E.bin
+    grep -q '^// \$[0-9a-f]*\$ -> x.sol:L_2$' E.bin
+)
+rm -rf "$SOLTMPDIR"
+
 printTask "Testing overwriting files..."
 SOLTMPDIR=$(mktemp -d)
 (
@@ -0,0 +1,2 @@
+pragma solidity >=0.0;
+contract C {}
@@ -0,0 +1,6 @@
+{
+    function f(a, b) -> c { c := add(mul(a, 2), b) }
+    let x := calldataload(0)
+    sstore(0, f(x, 3))
+    sstore(1, f(x, 3))
+}
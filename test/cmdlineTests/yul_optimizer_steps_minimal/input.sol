@@ -0,0 +1,4 @@
+{
+    let x := calldataload(0)
+    for { let i := 0 } lt(i, x) { i := add(i, 1) } { sstore(i, add(x, 0)) }
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the snapshots of InvertibleMap.
+ */
+
+#include <libdevcore/InvertibleMap.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(InvertibleMapTest)
+
+BOOST_AUTO_TEST_CASE(no_changes_without_snapshot)
+{
+	InvertibleMap<int, int> m;
+	m.set(1, 2);
+	size_t snapshot = m.takeSnapshot();
+	BOOST_CHECK(m.changesSince(snapshot).empty());
+	m.releaseSnapshot();
+}
+
+BOOST_AUTO_TEST_CASE(changes_since_snapshot)
+{
+	InvertibleMap<int, int> m;
+	m.set(1, 10);
+	m.set(2, 20);
+	m.set(3, 20);
+	size_t snapshot = m.takeSnapshot();
+	m.set(1, 11);
+	m.set(1, 12);
+	m.set(4, 40);
+	m.eraseValue(20);
+	map<int, optional<int>> expectation{{1, 10}, {2, 20}, {3, 20}, {4, nullopt}};
+	BOOST_CHECK(m.changesSince(snapshot) == expectation);
+	m.releaseSnapshot();
+
+	snapshot = m.takeSnapshot();
+	m.clear();
+	expectation = {{1, 12}, {4, 40}};
+	BOOST_CHECK(m.changesSince(snapshot) == expectation);
+	m.releaseSnapshot();
+}
+
+BOOST_AUTO_TEST_CASE(nested_snapshots)
+{
+	InvertibleMap<int, int> m;
+	m.set(1, 10);
+	size_t outer = m.takeSnapshot();
+	m.set(2, 20);
+	size_t inner = m.takeSnapshot();
+	m.eraseKey(1);
+	map<int, optional<int>> expectation{{1, 10}};
+	BOOST_CHECK(m.changesSince(inner) == expectation);
+	m.releaseSnapshot();
+	m.set(3, 30);
+	expectation = {{1, 10}, {2, nullopt}, {3, nullopt}};
+	BOOST_CHECK(m.changesSince(outer) == expectation);
+	m.releaseSnapshot();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -194,6 +194,43 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unmatched_tags)
+{
+	string templ = "a < <b <?c>x<!c>y </d> <#e> </f> <>";
+	BOOST_CHECK_EQUAL(Whiskers(templ).render(), templ);
+}
+
+BOOST_AUTO_TEST_CASE(condition_first_closing_tag)
+{
+	string templ = "<?c>1<?d>2</d>3<!c>4</c>5</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("d", false).render(), "135</c>");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("d", true).render(), "45</c>");
+}
+
+BOOST_AUTO_TEST_CASE(else_without_closing_tag)
+{
+	// The "<!c>" does not start an else branch because it is not followed by "</c>".
+	string templ = "<?c>a</c><!c>b";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false).render(), "<!c>b");
+}
+
+BOOST_AUTO_TEST_CASE(list_inside_condition)
+{
+	string templ = "<?c>[<#l><v>,</l>]</c>";
+	vector<map<string, string>> list(2);
+	list[0]["v"] = "1";
+	list[1]["v"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("l", list).render(), "[1,2,]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("l", list).render(), "");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_rendered_twice)
+{
+	string templ = "<a><?c>+<!c>-</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "x")("c", true).render(), "x+");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "y")("c", false).render(), "y-");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
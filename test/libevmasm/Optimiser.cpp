@@ -27,6 +27,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -800,6 +801,8 @@ BOOST_AUTO_TEST_CASE(block_deduplicator)
 		if (item.type() == PushTag)
 			pushTags.insert(item.data());
 	BOOST_CHECK_EQUAL(pushTags.size(), 2);
+	// JUMPDEST, PUSH1 6, SWAP3, JUMP of the block at tag 2
+	BOOST_CHECK_EQUAL(dedup.deduplicatedBytes(), 5);
 }
 
 BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
@@ -832,6 +835,8 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 		if (item.type() == PushTag)
 			pushTags.insert(item.data());
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
+	// JUMPDEST, PUSH1 5, PUSH1 6, SSTORE, PUSH3 tag, JUMP of the block at tag 2
+	BOOST_CHECK_EQUAL(dedup.deduplicatedBytes(), 11);
 }
 
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
@@ -1370,6 +1375,28 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache)
+{
+	auto optimise = [](u256 const& _value)
+	{
+		Assembly assembly;
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			assembly.append(_value);
+			assembly.append(Instruction::POP);
+		}
+		BOOST_CHECK(ConstantOptimisationMethod::optimiseConstants(false, 1, EVMVersion(), assembly) > 0);
+		return assembly.assemble().bytecode;
+	};
+	u256 const value = (u256(1) << 255) + 0x1234;
+
+	ComputeMethod::clearCache();
+	bytes const found = optimise(value);
+	// The representation of the constant is now taken from the cache.
+	BOOST_CHECK(optimise(value) == found);
+	BOOST_CHECK(found.size() < 4 * 34);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
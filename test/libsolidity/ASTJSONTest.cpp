@@ -18,6 +18,7 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Options.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/JSON.h>
 #include <liblangutil/SourceReferenceFormatterHuman.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -125,6 +126,18 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 
 	bool resultsMatch = true;
 
+	for (size_t i = 0; i < m_sources.size(); i++)
+		for (bool legacy: {false, true})
+		{
+			ostringstream result;
+			ASTJsonConverter(legacy, sourceIndices).printCompact(result, c.ast(m_sources[i].first));
+			if (result.str() != jsonCompactPrint(ASTJsonConverter(legacy, sourceIndices).toJson(c.ast(m_sources[i].first))))
+			{
+				AnsiColorized(_stream, _formatted, {BOLD, RED}) << _linePrefix << "Compact " << (legacy ? "legacy " : "") << "output of " << m_sources[i].first << " differs from the json tree." << endl;
+				resultsMatch = false;
+			}
+		}
+
 	if (m_expectation != m_result)
 	{
 		string nextIndentLevel = _linePrefix + "  ";
@@ -22,6 +22,8 @@
 #include <test/Metadata.h>
 #include <test/Options.h>
 
+#include <libyul/YulString.h>
+
 using namespace std;
 
 namespace dev
@@ -53,6 +55,67 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(identical_abi_functions_across_contracts)
+{
+	// The optimised ABI functions of B are taken from the cache filled while compiling A
+	// and have to result in the same code as when they are optimised for B itself.
+	char const* sourceCodeA = R"(
+		pragma experimental ABIEncoderV2;
+		contract A {
+			function f(uint[] memory a, bytes memory b) public pure returns (uint[] memory, bytes memory) { return (a, b); }
+		}
+	)";
+	char const* sourceCodeB = R"(
+		pragma experimental ABIEncoderV2;
+		contract B {
+			function f(uint[] memory a, bytes memory b) public pure returns (uint[] memory, bytes memory) { return (a, b); }
+		}
+	)";
+	auto compile = [&](string const& _sourceCode)
+	{
+		compiler().reset();
+		compiler().setSources({{"", "pragma solidity >=0.0;\n" + _sourceCode}});
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setOptimiserSettings(OptimiserSettings::full());
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+	};
+
+	// Resetting the Yul string repository also clears the cache.
+	yul::YulStringRepository::reset();
+	compile(sourceCodeB);
+	bytes const uncachedB = dev::test::bytecodeSansMetadata(compiler().runtimeObject("B").bytecode);
+
+	yul::YulStringRepository::reset();
+	compile(sourceCodeA);
+	bytes const runtimeA = dev::test::bytecodeSansMetadata(compiler().runtimeObject("A").bytecode);
+	compile(sourceCodeB);
+	bytes const cachedB = dev::test::bytecodeSansMetadata(compiler().runtimeObject("B").bytecode);
+
+	BOOST_CHECK(runtimeA == uncachedB);
+	BOOST_CHECK(cachedB == uncachedB);
+}
+
+BOOST_AUTO_TEST_CASE(optimized_ir_after_ewasm_generation)
+{
+	char const* sourceCode = "pragma solidity >=0.0; contract C { }";
+	for (bool keepOptimizedIR: {false, true})
+	{
+		compiler().reset();
+		compiler().setSources({{"", sourceCode}});
+		compiler().setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler().setOptimiserSettings(OptimiserSettings::full());
+		compiler().enableIRGeneration();
+		compiler().enableEWasmGeneration();
+		compiler().enableOptimizedIROutput(keepOptimizedIR);
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+		BOOST_CHECK(!compiler().eWasm("C").empty());
+		if (keepOptimizedIR)
+			BOOST_CHECK(compiler().yulIROptimized("C").find("object \"C_") != string::npos);
+		else
+			BOOST_CHECK_THROW(compiler().yulIROptimized("C"), langutil::CompilerError);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -20,6 +20,7 @@
  */
 
 #include <string>
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
@@ -1372,6 +1373,127 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(yul_optimizer_report)
+{
+	char const* input = R"(
+	{
+		"language": "Yul",
+		"sources": { "A": { "content": "{ let x := calldataload(0) sstore(add(x, 0), mul(x, 1)) }" } },
+		"settings":
+		{
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection": { "A": { "*": ["yulOptimizerReport"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& report = result["contracts"]["A"]["object"]["yulOptimizerReport"];
+	BOOST_REQUIRE(report.isObject());
+	BOOST_REQUIRE(report["ExpressionSimplifier"].isObject());
+	BOOST_CHECK(report["ExpressionSimplifier"]["runs"].asUInt64() > 0);
+	BOOST_CHECK(report["ExpressionSimplifier"]["microseconds"].isInt64());
+	BOOST_CHECK(report["ExpressionSimplifier"]["codeSizeChange"].isInt64());
+
+	// The wildcard does not request the report.
+	result = compile(boost::replace_first_copy(string(input), "[\"yulOptimizerReport\"]", "[\"*\"]"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["A"]["object"].isObject());
+	BOOST_CHECK(!result["contracts"]["A"]["object"].isMember("yulOptimizerReport"));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// File names are chosen such that the order of "file:contract" differs from the order of the files.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"a.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} } contract D {}" },
+			"a": { "content": "pragma solidity >=0.0; contract B { uint x; function g() public { x = 2; } }" },
+			"b": { "content": "contract E {}" }
+		},
+		"settings":
+		{
+			"outputSelection":
+			{
+				"a.sol": { "D": ["abi"] },
+				"*": { "*": ["abi", "evm.bytecode", "evm.methodIdentifiers"], "": ["ast", "legacyAST"] }
+			}
+		}
+	}
+	)";
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"sources": { "a": { "content": "contract C { function f() public { x = 1; } }" } }
+	}
+	)";
+	for (string const& json: {string(input), string(invalidInput), string("{}"), string("invalid")})
+	{
+		dev::solidity::StandardCompiler compiler;
+		string expectation = compiler.compile(json);
+		string streamed;
+		size_t pieces = 0;
+		BOOST_CHECK(compiler.compile(json, [&](string const& _part) { streamed += _part; pieces++; }));
+		BOOST_CHECK_EQUAL(streamed, expectation);
+		BOOST_CHECK(pieces > 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(bounded_memory)
+{
+	// B creates A, which is defined in a source whose AST is not requested.
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"a": { "content": "pragma solidity >=0.0; contract A { uint x; function f() public { x = 1; } }" },
+			"b": { "content": "pragma solidity >=0.0; import \"a\"; contract B { function g() public { new A(); } }" },
+			"c": { "content": "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 7; } }" }
+		},
+		"settings":
+		{
+			"boundedMemory": <boundedMemory>,
+			"outputSelection":
+			{
+				"*": { "*": ["abi", "metadata", "evm.bytecode", "evm.gasEstimates"] },
+				"c": { "": ["ast"] }
+			}
+		}
+	}
+	)";
+	auto withBoundedMemory = [&](bool _enabled) {
+		return boost::replace_first_copy(string(input), "<boundedMemory>", _enabled ? "true" : "false");
+	};
+
+	dev::solidity::StandardCompiler compiler;
+	Json::Value expectation;
+	BOOST_REQUIRE(jsonParseStrict(compiler.compile(withBoundedMemory(false)), expectation));
+	BOOST_CHECK(!expectation.isMember("statistics"));
+
+	string streamed;
+	BOOST_CHECK(compiler.compile(withBoundedMemory(true), [&](string const& _part) { streamed += _part; }));
+
+	Json::Value result;
+	BOOST_REQUIRE(jsonParseStrict(streamed, result));
+	BOOST_REQUIRE(result["statistics"].isObject());
+	BOOST_CHECK(result["statistics"]["processPeakMemory"].isUInt64());
+	result.removeMember("statistics");
+	BOOST_CHECK(result == expectation);
+
+	// The peak memory usage differs between runs, so it is not part of the comparison.
+	Json::Value unstreamed;
+	BOOST_REQUIRE(jsonParseStrict(compiler.compile(withBoundedMemory(true)), unstreamed));
+	BOOST_REQUIRE(unstreamed["statistics"].isObject());
+	unstreamed.removeMember("statistics");
+	BOOST_CHECK(unstreamed == result);
+	BOOST_CHECK(result["contracts"]["b"]["B"]["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(result["sources"]["c"]["ast"].isObject());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
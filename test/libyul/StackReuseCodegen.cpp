@@ -32,11 +32,12 @@ namespace test
 
 namespace
 {
-string assemble(string const& _input)
+string assemble(string const& _input, bool _optimizeStackLayout = false)
 {
 	dev::solidity::OptimiserSettings settings = dev::solidity::OptimiserSettings::full();
 	settings.runYulOptimiser = false;
 	settings.optimizeStackAllocation = true;
+	settings.optimizeStackLayout = _optimizeStackLayout;
 	AssemblyStack asmStack(langutil::EVMVersion{}, AssemblyStack::Language::StrictAssembly, settings);
 	BOOST_REQUIRE_MESSAGE(asmStack.parseAndAnalyze("", _input), "Source did not parse: " + _input);
 	return dev::eth::disassemble(asmStack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode);
@@ -345,6 +346,40 @@ BOOST_AUTO_TEST_CASE(reuse_slots_function_with_gaps)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(stack_layout_consume_last_use)
+{
+	string in = "{ let x := mload(0) sstore(0, x) }";
+	BOOST_CHECK_EQUAL(assemble(in), "PUSH1 0x0 MLOAD DUP1 PUSH1 0x0 SSTORE POP ");
+	BOOST_CHECK_EQUAL(assemble(in, true), "PUSH1 0x0 MLOAD PUSH1 0x0 SSTORE ");
+}
+
+BOOST_AUTO_TEST_CASE(stack_layout_chain)
+{
+	string in = "{ let x := mload(0) let y := add(1, x) let z := mul(2, y) sstore(0, z) }";
+	BOOST_CHECK_EQUAL(assemble(in, true), "PUSH1 0x0 MLOAD PUSH1 0x1 ADD PUSH1 0x2 MUL PUSH1 0x0 SSTORE ");
+}
+
+BOOST_AUTO_TEST_CASE(stack_layout_not_on_top)
+{
+	// x is not the topmost slot when it is read, so it has to be duplicated.
+	string in = "{ let x := mload(0) let y := mload(1) sstore(y, x) }";
+	BOOST_CHECK_EQUAL(assemble(in, true), "PUSH1 0x0 MLOAD PUSH1 0x1 MLOAD DUP2 DUP2 SSTORE POP POP ");
+}
+
+BOOST_AUTO_TEST_CASE(stack_layout_outer_scope)
+{
+	// The last reference is in a nested block, so the variable is not consumed there.
+	string in = "{ let z := mload(0) { sstore(0, z) } }";
+	BOOST_CHECK_EQUAL(assemble(in, true), assemble(in));
+}
+
+BOOST_AUTO_TEST_CASE(stack_layout_for_loop_condition)
+{
+	// The condition is evaluated repeatedly, so x must not be consumed there.
+	string in = "{ for { let x := mload(0) } x { } { sstore(0, 1) } }";
+	BOOST_CHECK_EQUAL(assemble(in, true), assemble(in));
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
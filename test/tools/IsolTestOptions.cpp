@@ -59,6 +59,7 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "Number of worker processes to run the tests in. With more than one, failing tests are reported without asking how to proceed.")
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
@@ -84,6 +85,10 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs has to be at least one.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running tests in parallel is not supported on Windows.");
+#endif
 }
 
 }
@@ -33,6 +33,7 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	size_t jobs = 1;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
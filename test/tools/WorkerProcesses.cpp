@@ -0,0 +1,168 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file WorkerProcesses.cpp
+ */
+
+#include <test/tools/WorkerProcesses.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+namespace
+{
+
+#if !defined(_WIN32)
+bool writeAll(int _fd, void const* _data, size_t _size)
+{
+	auto data = static_cast<char const*>(_data);
+	while (_size > 0)
+	{
+		ssize_t written = write(_fd, data, _size);
+		if (written <= 0)
+			return false;
+		data += written;
+		_size -= size_t(written);
+	}
+	return true;
+}
+
+bool readAll(int _fd, void* _data, size_t _size)
+{
+	auto data = static_cast<char*>(_data);
+	while (_size > 0)
+	{
+		ssize_t received = read(_fd, data, _size);
+		if (received <= 0)
+			return false;
+		data += received;
+		_size -= size_t(received);
+	}
+	return true;
+}
+#endif
+
+}
+
+vector<optional<bytes>> runInWorkerProcesses(
+	size_t _taskCount,
+	size_t _jobs,
+	function<bytes(size_t)> const& _runTask
+)
+{
+	vector<optional<bytes>> results(_taskCount);
+	size_t const jobs = min(_jobs, _taskCount);
+#if !defined(_WIN32)
+	if (jobs > 1)
+	{
+		struct Worker
+		{
+			pid_t pid;
+			FILE* output;
+			int resultPipe;
+			size_t firstTask;
+		};
+		vector<Worker> workers;
+		cout.flush();
+
+		for (size_t job = 0; job < jobs; ++job)
+		{
+			FILE* output = tmpfile();
+			int resultPipe[2];
+			pid_t pid = -1;
+			if (output && pipe(resultPipe) == 0)
+			{
+				pid = fork();
+				if (pid < 0)
+				{
+					close(resultPipe[0]);
+					close(resultPipe[1]);
+				}
+			}
+			if (pid < 0)
+			{
+				// Could not start a worker, run its tasks here.
+				if (output)
+					fclose(output);
+				for (size_t task = job; task < _taskCount; task += jobs)
+					results[task] = _runTask(task);
+				continue;
+			}
+			if (pid == 0)
+			{
+				close(resultPipe[0]);
+				dup2(fileno(output), STDOUT_FILENO);
+				bool written = true;
+				for (size_t task = job; task < _taskCount && written; task += jobs)
+				{
+					bytes result = _runTask(task);
+					uint64_t size = result.size();
+					written =
+						writeAll(resultPipe[1], &size, sizeof(size)) &&
+						writeAll(resultPipe[1], result.data(), result.size());
+				}
+				cout.flush();
+				_exit(written ? 0 : 1);
+			}
+			close(resultPipe[1]);
+			workers.push_back({pid, output, resultPipe[0], job});
+		}
+
+		for (Worker const& worker: workers)
+		{
+			for (size_t task = worker.firstTask; task < _taskCount; task += jobs)
+			{
+				uint64_t size = 0;
+				if (!readAll(worker.resultPipe, &size, sizeof(size)))
+					break;
+				bytes result(size);
+				if (!readAll(worker.resultPipe, result.data(), result.size()))
+					break;
+				results[task] = move(result);
+			}
+			close(worker.resultPipe);
+			waitpid(worker.pid, nullptr, 0);
+
+			rewind(worker.output);
+			char buffer[4096];
+			while (size_t length = fread(buffer, 1, sizeof(buffer), worker.output))
+				cout.write(buffer, streamsize(length));
+			fclose(worker.output);
+		}
+		return results;
+	}
+#endif
+	for (size_t task = 0; task < _taskCount; ++task)
+		results[task] = _runTask(task);
+	return results;
+}
+
+}
+}
@@ -0,0 +1,48 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file WorkerProcesses.h
+ * Runs independent tasks of the test tools in forked worker processes.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace dev
+{
+namespace test
+{
+
+/// Runs the tasks 0, ..., @a _taskCount - 1 in up to @a _jobs forked worker processes, which
+/// each have their own compiler state. The tasks are distributed round-robin. @a _runTask is
+/// called in a worker and returns the result of a task, which is passed back through a pipe.
+/// The standard output of the workers is printed in the order of the workers once they are
+/// finished. If worker processes are not available, the tasks are run in this process.
+/// @returns the results in the order of the tasks, std::nullopt for tasks whose worker
+/// terminated before passing back their result.
+std::vector<std::optional<bytes>> runInWorkerProcesses(
+	size_t _taskCount,
+	size_t _jobs,
+	std::function<bytes(size_t)> const& _runTask
+);
+
+}
+}
@@ -20,6 +20,7 @@
 
 #include <test/Common.h>
 #include <test/tools/IsolTestOptions.h>
+#include <test/tools/WorkerProcesses.h>
 #include <test/libsolidity/AnalysisFramework.h>
 #include <test/InteractiveTests.h>
 #include <test/EVMHost.h>
@@ -132,6 +133,27 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the paths of all test files in @a _path (relative to @a _basepath).
+	static vector<fs::path> collectTests(fs::path const& _basepath, fs::path const& _path);
+
+	/// Runs the tests one after the other, asking how to proceed after each failure.
+	static TestStats processInteractively(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _tests
+	);
+
+	/// Distributes the tests across worker processes, which each have their own compiler
+	/// state. The output of the workers is printed in the order of the workers once
+	/// they are finished. Failures are reported without asking how to proceed.
+	static TestStats processInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _tests
+	);
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
 	TestFilter m_filter;
@@ -247,27 +269,20 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
-	fs::path const& _basepath,
-	fs::path const& _path
-)
+vector<fs::path> TestTool::collectTests(fs::path const& _basepath, fs::path const& _path)
 {
+	vector<fs::path> tests;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -275,10 +290,46 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
+		else
+			tests.push_back(currentPath);
+	}
+
+	return tests;
+}
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path
+)
+{
+	vector<fs::path> tests = collectTests(_basepath, _path);
+	if (_options.jobs > 1 && tests.size() > 1)
+		return processInParallel(_testCaseCreator, _options, _basepath, tests);
+	else
+		return processInteractively(_testCaseCreator, _options, _basepath, tests);
+}
+
+TestStats TestTool::processInteractively(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _tests
+)
+{
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+
+	for (size_t i = 0; i < _tests.size();)
+	{
+		auto const& currentPath = _tests[i];
+
+		if (m_exitRequested)
 		{
 			++testCount;
-			paths.pop();
+			++i;
 		}
 		else
 		{
@@ -286,7 +337,7 @@ TestStats TestTool::processPath(
 			TestTool testTool(
 				_testCaseCreator,
 				_options,
-				fullpath,
+				_basepath / currentPath,
 				currentPath.generic_path().string()
 			);
 			auto result = testTool.process();
@@ -298,7 +349,7 @@ TestStats TestTool::processPath(
 				switch(testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
+					++i;
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
@@ -306,17 +357,17 @@ TestStats TestTool::processPath(
 					--testCount;
 					break;
 				case Request::Skip:
-					paths.pop();
+					++i;
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
+				++i;
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
+				++i;
 				++skippedCount;
 				break;
 			}
@@ -324,7 +375,42 @@ TestStats TestTool::processPath(
 	}
 
 	return { successCount, testCount, skippedCount };
+}
 
+TestStats TestTool::processInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _tests
+)
+{
+	vector<optional<bytes>> results = dev::test::runInWorkerProcesses(
+		_tests.size(),
+		_options.jobs,
+		[&](size_t _test) {
+			TestTool testTool(
+				_testCaseCreator,
+				_options,
+				_basepath / _tests[_test],
+				_tests[_test].generic_path().string()
+			);
+			return bytes{uint8_t(testTool.process())};
+		}
+	);
+
+	TestStats stats{0, int(_tests.size()), 0};
+	bool terminated = false;
+	for (optional<bytes> const& result: results)
+		if (!result || result->size() != 1)
+			// Tests of a worker that terminated unexpectedly count as failed.
+			terminated = true;
+		else if (Result((*result)[0]) == Result::Success)
+			++stats.successCount;
+		else if (Result((*result)[0]) == Result::Skipped)
+			++stats.skippedCount;
+	if (terminated)
+		AnsiColorized(cout, !_options.noColor, {BOLD, RED}) << "Test worker terminated unexpectedly." << endl;
+	return stats;
 }
 
 namespace
@@ -33,7 +33,6 @@
 
 #include <libdevcore/FixedHash.h>
 
-#include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
 
 #include <ostream>
@@ -44,6 +43,17 @@ using namespace dev;
 using namespace yul;
 using namespace yul::test;
 
+uint8_t& InterpreterMemory::operator[](u256 const& _offset)
+{
+	u256 pageIndex = _offset / PageSize;
+	if (!m_cachedPage || pageIndex != m_cachedPageIndex)
+	{
+		m_cachedPage = &m_pages[pageIndex];
+		m_cachedPageIndex = pageIndex;
+	}
+	return (*m_cachedPage)[size_t(_offset % PageSize)];
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
@@ -51,8 +61,13 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
 	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * size_t(offset % 0x20));
+	for (auto const& [pageIndex, page]: memory.pages())
+		for (size_t i = 0; i < page.size(); ++i)
+			if (page[i])
+			{
+				u256 offset = pageIndex * InterpreterMemory::PageSize + i;
+				words[(offset / 0x20) * 0x20] |= u256(uint32_t(page[i])) << (256 - 8 - 8 * size_t(offset % 0x20));
+			}
 	for (auto const& [offset, value]: words)
 		if (value != 0)
 			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
@@ -183,14 +198,14 @@ void Interpreter::operator()(Block const& _block)
 
 u256 Interpreter::evaluate(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_scopes);
+	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_inheritedScopes, m_scopes);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_scopes);
+	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_inheritedScopes, m_scopes);
 	ev.visit(_expression);
 	return ev.values();
 }
@@ -251,13 +266,13 @@ void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 
 	solAssert(fun, "Function not found.");
 	solAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
+	InterpreterVariables variables;
 	for (size_t i = 0; i < fun->parameters.size(); ++i)
 		variables[fun->parameters.at(i).name] = m_values.at(i);
 	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
 		variables[fun->returnVariables.at(i).name] = 0;
 
-	Interpreter interpreter(m_state, m_dialect, variables, functionScopes);
+	Interpreter interpreter(m_state, m_dialect, move(variables), move(functionScopes));
 	interpreter(fun->body);
 
 	m_values.clear();
@@ -279,37 +294,34 @@ void ExpressionEvaluator::setValue(u256 _value)
 
 void ExpressionEvaluator::evaluateArgs(vector<Expression> const& _expr)
 {
-	vector<u256> values;
+	vector<u256> values(_expr.size());
 	/// Function arguments are evaluated in reverse.
-	for (auto const& expr: _expr | boost::adaptors::reversed)
+	for (size_t i = _expr.size(); i > 0; --i)
 	{
-		visit(expr);
-		values.push_back(value());
+		visit(_expr[i - 1]);
+		values[i - 1] = value();
 	}
 	m_values = std::move(values);
-	std::reverse(m_values.begin(), m_values.end());
 }
 
 pair<
-	vector<map<YulString, FunctionDefinition const*>>,
+	vector<InterpreterScope const*>,
 	FunctionDefinition const*
 > ExpressionEvaluator::findFunctionAndScope(YulString _functionName) const
 {
-	FunctionDefinition const* fun = nullptr;
-	std::vector<std::map<YulString, FunctionDefinition const*>> newScopes;
-	for (auto const& scope: m_scopes)
-	{
-		// Copy over all functions.
-		newScopes.push_back({});
-		for (auto const& [name, funDef]: scope)
-			if (funDef)
-				newScopes.back().emplace(name, funDef);
-		// Stop at the called function.
-		if (scope.count(_functionName))
-		{
-			fun = scope.at(_functionName);
-			break;
-		}
-	}
-	return {move(newScopes), fun};
+	// The scopes are shared, the function does not see the variables in them
+	// because it is executed with its own set of variables.
+	vector<InterpreterScope const*> scopes;
+	auto visit = [&](InterpreterScope const& _scope) -> FunctionDefinition const* {
+		scopes.push_back(&_scope);
+		auto it = _scope.find(_functionName);
+		return it == _scope.end() ? nullptr : it->second;
+	};
+	for (InterpreterScope const* scope: m_inheritedScopes)
+		if (FunctionDefinition const* fun = visit(*scope))
+			return {move(scopes), fun};
+	for (InterpreterScope const& scope: m_scopes)
+		if (FunctionDefinition const* fun = visit(scope))
+			return {move(scopes), fun};
+	return {move(scopes), nullptr};
 }
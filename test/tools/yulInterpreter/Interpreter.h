@@ -28,7 +28,9 @@
 
 #include <libdevcore/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace yul
 {
@@ -60,11 +62,43 @@ enum class LoopState
 	Break,
 };
 
+/**
+ * Sparse byte-addressable memory of the interpreter. It is stored in pages that are allocated
+ * (and zero-initialised) when a byte inside them is accessed for the first time. The page
+ * accessed last is cached, since consecutive accesses usually hit the same page.
+ */
+class InterpreterMemory
+{
+public:
+	static size_t constexpr PageSize = 256;
+	using Page = std::array<uint8_t, PageSize>;
+
+	InterpreterMemory() = default;
+	InterpreterMemory(InterpreterMemory const& _other): m_pages(_other.m_pages) {}
+	InterpreterMemory& operator=(InterpreterMemory const& _other)
+	{
+		m_pages = _other.m_pages;
+		m_cachedPage = nullptr;
+		return *this;
+	}
+
+	/// @returns the byte at @a _offset, allocating its page if necessary.
+	uint8_t& operator[](dev::u256 const& _offset);
+
+	/// @returns the allocated pages, keyed by the offset of their first byte divided by the page size.
+	std::map<dev::u256, Page> const& pages() const { return m_pages; }
+
+private:
+	std::map<dev::u256, Page> m_pages;
+	dev::u256 m_cachedPageIndex;
+	Page* m_cachedPage = nullptr;
+};
+
 struct InterpreterState
 {
 	dev::bytes calldata;
 	dev::bytes returndata;
-	std::map<dev::u256, uint8_t> memory;
+	InterpreterMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	dev::u256 msize;
 	std::map<dev::h256, dev::h256> storage;
@@ -95,22 +129,30 @@ struct InterpreterState
 	void dumpTraceAndState(std::ostream& _out) const;
 };
 
+/// Values of variables.
+using InterpreterVariables = std::unordered_map<YulString, dev::u256>;
+/// Variables and functions declared in a scope. The pointer is nullptr if and only if the
+/// key is a variable.
+using InterpreterScope = std::map<YulString, FunctionDefinition const*>;
+
 /**
  * Yul interpreter.
  */
 class Interpreter: public ASTWalker
 {
 public:
+	/// @param _inheritedScopes scopes of the enclosing function calls that are visible
+	/// to the code. Only their functions are used, they have to outlive the interpreter.
 	Interpreter(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		std::map<YulString, dev::u256> _variables = {},
-		std::vector<std::map<YulString, FunctionDefinition const*>> _scopes = {}
+		InterpreterVariables _variables = {},
+		std::vector<InterpreterScope const*> _inheritedScopes = {}
 	):
 		m_dialect(_dialect),
 		m_state(_state),
 		m_variables(std::move(_variables)),
-		m_scopes(std::move(_scopes))
+		m_inheritedScopes(std::move(_inheritedScopes))
 	{}
 
 	void operator()(ExpressionStatement const& _statement) override;
@@ -141,11 +183,14 @@ private:
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
 	/// Values of variables.
-	std::map<YulString, dev::u256> m_variables;
-	/// Scopes of variables and functions. Used for lookup, clearing at end of blocks
-	/// and passing over the visible functions across function calls.
-	/// The pointer is nullptr if and only if the key is a variable.
-	std::vector<std::map<YulString, FunctionDefinition const*>> m_scopes;
+	InterpreterVariables m_variables;
+	/// Scopes visible from the function currently executed, outside of its body.
+	/// They are shared with the interpreters of the enclosing calls instead of copied.
+	std::vector<InterpreterScope const*> m_inheritedScopes;
+	/// Scopes of variables and functions of the code executed by this interpreter.
+	/// Used for lookup, clearing at end of blocks and passing over the visible functions
+	/// across function calls.
+	std::vector<InterpreterScope> m_scopes;
 };
 
 /**
@@ -157,12 +202,14 @@ public:
 	ExpressionEvaluator(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		std::map<YulString, dev::u256> const& _variables,
-		std::vector<std::map<YulString, FunctionDefinition const*>> const& _scopes
+		InterpreterVariables const& _variables,
+		std::vector<InterpreterScope const*> const& _inheritedScopes,
+		std::vector<InterpreterScope> const& _scopes
 	):
 		m_state(_state),
 		m_dialect(_dialect),
 		m_variables(_variables),
+		m_inheritedScopes(_inheritedScopes),
 		m_scopes(_scopes)
 	{}
 
@@ -184,18 +231,19 @@ private:
 	void evaluateArgs(std::vector<Expression> const& _expr);
 
 	/// Finds the function called @a _functionName in the current scope stack and returns
-	/// the function's scope stack (with variables removed) and definition.
+	/// the scopes visible to the function (up to its declaring scope) and its definition.
 	std::pair<
-		std::vector<std::map<YulString, FunctionDefinition const*>>,
+		std::vector<InterpreterScope const*>,
 		FunctionDefinition const*
 	> findFunctionAndScope(YulString _functionName) const;
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
 	/// Values of variables.
-	std::map<YulString, dev::u256> const& m_variables;
-	/// Stack of scopes in the current context.
-	std::vector<std::map<YulString, FunctionDefinition const*>> const& m_scopes;
+	InterpreterVariables const& m_variables;
+	/// Stack of scopes in the current context, see Interpreter.
+	std::vector<InterpreterScope const*> const& m_inheritedScopes;
+	std::vector<InterpreterScope> const& m_scopes;
 	/// Current value of the expression
 	std::vector<dev::u256> m_values;
 };
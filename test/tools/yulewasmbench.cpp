@@ -0,0 +1,132 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for the translation of Yul code from EVM dialect to eWasm dialect.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/wasm/EVMToEWasmTranslator.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace langutil;
+using namespace yul;
+using namespace dev;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+bool benchmark(string const& _source, size_t _repetitions)
+{
+	AssemblyStack stack(
+		langutil::EVMVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		solidity::OptimiserSettings::none()
+	);
+	if (!stack.parseAndAnalyze("--INPUT--", _source))
+	{
+		for (auto const& error: stack.errors())
+			SourceReferenceFormatter(cerr).printErrorInformation(*error);
+		return false;
+	}
+	Object const& object = *stack.parserResult();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion());
+
+	// The first translation also parses the polyfill, report it separately.
+	auto start = chrono::steady_clock::now();
+	EVMToEWasmTranslator(dialect).run(object);
+	auto firstRun = chrono::steady_clock::now() - start;
+
+	start = chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		EVMToEWasmTranslator(dialect).run(object);
+	auto total = chrono::steady_clock::now() - start;
+
+	auto microseconds = [](auto _duration) { return chrono::duration_cast<chrono::microseconds>(_duration).count(); };
+	cout << "First translation: " << microseconds(firstRun) << " us" << endl;
+	if (_repetitions > 0)
+	{
+		double seconds = chrono::duration<double>(total).count();
+		cout << "Translations: " << _repetitions << endl;
+		cout << "Average translation: " << microseconds(total) / _repetitions << " us" << endl;
+		if (seconds > 0)
+			cout << "Throughput: " << size_t(double(_source.size() * _repetitions) / seconds / 1024) << " KiB/s" << endl;
+	}
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulewasmbench, benchmark for the translation from EVM-flavoured Yul to eWasm.
+Usage: yulewasmbench [Options] < input
+Reads a single Yul object from stdin, translates it repeatedly and prints timing statistics.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(100), "Number of timed translations.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	string input;
+	if (arguments.count("input-file"))
+		for (string path: arguments["input-file"].as<vector<string>>())
+			input += readFileAsString(path);
+	else
+		input = readStandardInput();
+
+	return benchmark(input, arguments["repeat"].as<size_t>()) ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Searches for a Yul optimiser step sequence that produces small bytecode for a corpus of
+ * Yul objects, using hill climbing with random mutations of the step sequence.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <test/tools/WorkerProcesses.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+using namespace langutil;
+using namespace yul;
+using namespace dev;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+struct Score
+{
+	/// False if the optimiser or the code generator failed for any of the sources.
+	bool valid = false;
+	/// Total size of the bytecode of all sources.
+	size_t bytes = 0;
+	/// Total wall time spent in the optimiser.
+	double seconds = 0;
+
+	double cost(double _timeWeight) const
+	{
+		return valid ? double(bytes) + _timeWeight * seconds : numeric_limits<double>::infinity();
+	}
+};
+
+class SequenceTuner
+{
+public:
+	SequenceTuner(vector<string> _sources, double _timeWeight, size_t _jobs, unsigned _seed):
+		m_sources(move(_sources)), m_timeWeight(_timeWeight), m_jobs(_jobs), m_random(_seed)
+	{
+		for (auto const& abbreviation: OptimiserSuite::stepAbbreviationToNameMap())
+			m_abbreviations.push_back(abbreviation.first);
+	}
+
+	/// Compiles all sources using the optimiser step sequence @a _sequence.
+	Score evaluate(string const& _sequence) const
+	{
+		Score score;
+		score.valid = true;
+		solidity::OptimiserSettings settings = solidity::OptimiserSettings::full();
+		settings.yulOptimiserSteps = _sequence;
+		for (string const& source: m_sources)
+			try
+			{
+				AssemblyStack stack(EVMVersion(), AssemblyStack::Language::StrictAssembly, settings);
+				if (!stack.parseAndAnalyze("", source))
+					return Score{};
+				auto start = chrono::steady_clock::now();
+				stack.optimize();
+				score.seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+				score.bytes += stack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode.size();
+			}
+			catch (...)
+			{
+				return Score{};
+			}
+		return score;
+	}
+
+	/// Evaluates all candidates, using up to m_jobs worker processes.
+	vector<Score> evaluate(vector<string> const& _candidates) const
+	{
+		static_assert(is_trivially_copyable<Score>::value, "Scores are passed back from the workers as raw bytes.");
+		vector<optional<bytes>> results = dev::test::runInWorkerProcesses(
+			_candidates.size(),
+			m_jobs,
+			[&](size_t _candidate) {
+				Score score = evaluate(_candidates[_candidate]);
+				bytes result(sizeof(score));
+				memcpy(result.data(), &score, sizeof(score));
+				return result;
+			}
+		);
+		vector<Score> scores(_candidates.size());
+		for (size_t i = 0; i < results.size(); ++i)
+			// Candidates of a worker that terminated unexpectedly stay invalid.
+			if (results[i] && results[i]->size() == sizeof(Score))
+				memcpy(&scores[i], results[i]->data(), sizeof(Score));
+		return scores;
+	}
+
+	/// Replaces, inserts or removes a random step. Brackets are left in place.
+	string mutate(string _sequence)
+	{
+		vector<size_t> stepPositions;
+		for (size_t i = 0; i < _sequence.size(); ++i)
+			if (_sequence[i] != '[' && _sequence[i] != ']')
+				stepPositions.push_back(i);
+		char step = m_abbreviations[uniform_int_distribution<size_t>(0, m_abbreviations.size() - 1)(m_random)];
+
+		switch (stepPositions.empty() ? 1 : uniform_int_distribution<int>(0, 2)(m_random))
+		{
+		case 0:
+			_sequence[randomElement(stepPositions)] = step;
+			break;
+		case 1:
+			_sequence.insert(_sequence.begin() + ptrdiff_t(uniform_int_distribution<size_t>(0, _sequence.size())(m_random)), step);
+			break;
+		default:
+			_sequence.erase(randomElement(stepPositions), 1);
+			break;
+		}
+		return _sequence;
+	}
+
+	double cost(Score const& _score) const { return _score.cost(m_timeWeight); }
+
+private:
+	size_t randomElement(vector<size_t> const& _elements)
+	{
+		return _elements[uniform_int_distribution<size_t>(0, _elements.size() - 1)(m_random)];
+	}
+
+	vector<string> m_sources;
+	double m_timeWeight = 0;
+	size_t m_jobs = 1;
+	mt19937 m_random;
+	vector<char> m_abbreviations;
+};
+
+void printScore(string const& _label, string const& _sequence, Score const& _score)
+{
+	cout << _label << ": " << _sequence << endl;
+	if (_score.valid)
+		cout << "  " << _score.bytes << " bytes, " << size_t(_score.seconds * 1000) << " ms optimiser time" << endl;
+	else
+		cout << "  failed to compile" << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulseqtune, searches for a Yul optimiser step sequence that minimises the bytecode size.
+Usage: yulseqtune [Options] <file>...
+Each file has to contain a Yul object in strict assembly. Starting from the given sequence,
+random mutations are evaluated in each round and the best one is kept if it is an improvement.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		(
+			"sequence",
+			po::value<string>()->default_value(solidity::OptimiserSettings::DefaultYulOptimiserSteps),
+			"Step sequence to start from."
+		)
+		("rounds", po::value<size_t>()->default_value(50), "Number of rounds.")
+		("candidates", po::value<size_t>()->default_value(8), "Number of mutated sequences evaluated per round.")
+		(
+			"time-weight",
+			po::value<double>()->default_value(0),
+			"Cost of one second of optimiser time in bytes of bytecode. If this is not zero, "
+			"the result depends on the timing of the machine and on --jobs, because the workers "
+			"slow each other down."
+		)
+		("jobs,j", po::value<size_t>()->default_value(1), "Number of worker processes used to evaluate candidates.")
+		("seed", po::value<unsigned>()->default_value(0), "Seed of the random number generator.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	string sequence = arguments["sequence"].as<string>();
+	try
+	{
+		OptimiserSuite::validateSequence(sequence);
+	}
+	catch (OptimizerException const& _exception)
+	{
+		cerr << "Invalid sequence: " << *boost::get_error_info<errinfo_comment>(_exception) << endl;
+		return 1;
+	}
+	size_t jobs = arguments["jobs"].as<size_t>();
+
+	vector<string> sources;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		sources.push_back(readFileAsString(path));
+		AssemblyStack stack(EVMVersion(), AssemblyStack::Language::StrictAssembly, solidity::OptimiserSettings::none());
+		if (!stack.parseAndAnalyze(path, sources.back()))
+		{
+			for (auto const& error: stack.errors())
+				SourceReferenceFormatter(cerr).printErrorInformation(*error);
+			return 1;
+		}
+	}
+
+	double timeWeight = arguments["time-weight"].as<double>();
+	SequenceTuner tuner(move(sources), timeWeight, jobs, arguments["seed"].as<unsigned>());
+
+	Score initialScore = tuner.evaluate(sequence);
+	printScore("Initial sequence", sequence, initialScore);
+	Score bestScore = initialScore;
+
+	size_t const rounds = arguments["rounds"].as<size_t>();
+	size_t const candidateCount = max<size_t>(arguments["candidates"].as<size_t>(), 1);
+	for (size_t round = 1; round <= rounds; ++round)
+	{
+		vector<string> candidates;
+		for (size_t i = 0; i < candidateCount; ++i)
+			candidates.push_back(tuner.mutate(sequence));
+		vector<Score> scores = tuner.evaluate(candidates);
+
+		size_t best = 0;
+		for (size_t i = 1; i < scores.size(); ++i)
+			if (tuner.cost(scores[i]) < tuner.cost(scores[best]))
+				best = i;
+		if (tuner.cost(scores[best]) < tuner.cost(bestScore))
+		{
+			sequence = candidates[best];
+			bestScore = scores[best];
+			printScore("Round " + to_string(round), sequence, bestScore);
+		}
+	}
+
+	cout << endl;
+	printScore("Initial sequence", arguments["sequence"].as<string>(), initialScore);
+	printScore("Best sequence", sequence, bestScore);
+	return 0;
+}